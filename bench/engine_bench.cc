@@ -0,0 +1,157 @@
+/**
+ * Engine benchmark — sync vs callback server engine.
+ *
+ * Forks an app serving a gateway (streams that stay open, one token every
+ * 10 ms) and a tool (1 ms of simulated I/O per Execute). The parent opens N
+ * concurrent gateway streams, then measures unary Execute latency and
+ * throughput alongside them.
+ *
+ * Usage: engine_bench [streams=64] [calls=2000] [clients=8] [threads=4] [sync|callback]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <grpcpp/grpcpp.h>
+
+#include "proto/apps/v0/gateway.grpc.pb.h"
+#include "proto/apps/v0/tool.grpc.pb.h"
+
+extern "C" {
+#include "nebo/nebo.h"
+}
+
+namespace apb = apps::v0;
+using Clock = std::chrono::steady_clock;
+
+static int bench_execute(const char *, char **output, int *is_error) {
+    usleep(1000);
+    *output = strdup("ok");
+    *is_error = 0;
+    return 0;
+}
+
+static int bench_stream(const nebo_gateway_request_t *, nebo_push_gateway_event_fn push, void *ctx) {
+    nebo_gateway_event_t evt = {"text", "tok", "bench", ""};
+    while (push(&evt, ctx) == 0) usleep(10000);
+    return 0;
+}
+
+static int serve(nebo_engine_t engine, int threads) {
+    static nebo_tool_handler_t tool = {"bench", "bench tool", "{}", bench_execute, nullptr};
+    static nebo_gateway_handler_t gw = {bench_stream, nullptr};
+    nebo_app_t *app = nebo_app_new();
+    nebo_app_register_tool(app, &tool);
+    nebo_app_register_gateway(app, &gw);
+    nebo_app_set_engine(app, engine, threads);
+    return nebo_app_run(app);
+}
+
+/* The server runs in a fresh exec of this binary; gRPC does not survive fork(). */
+static pid_t start_server(const char *sock, nebo_engine_t engine, int threads) {
+    pid_t pid = fork();
+    if (pid != 0) return pid;
+
+    char engine_arg[16], threads_arg[16];
+    snprintf(engine_arg, sizeof(engine_arg), "%d", (int)engine);
+    snprintf(threads_arg, sizeof(threads_arg), "%d", threads);
+    setenv("NEBO_APP_SOCK", sock, 1);
+    setenv("NEBO_APP_NAME", "bench", 1);
+    execl("/proc/self/exe", "engine_bench", "--serve", engine_arg, threads_arg, (char *)nullptr);
+    _exit(127);
+}
+
+static void run(const char *label, nebo_engine_t engine, int streams, int calls, int clients,
+                int threads) {
+    char sock[64];
+    snprintf(sock, sizeof(sock), "/tmp/nebo-bench-%d.sock", (int)getpid());
+    pid_t pid = start_server(sock, engine, threads);
+
+    auto channel = grpc::CreateChannel(std::string("unix:") + sock, grpc::InsecureChannelCredentials());
+    if (!channel->WaitForConnected(std::chrono::system_clock::now() + std::chrono::seconds(5))) {
+        fprintf(stderr, "%s: server did not start\n", label);
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+        return;
+    }
+    auto gw = apb::GatewayService::NewStub(channel);
+    auto tool = apb::ToolService::NewStub(channel);
+
+    /* Open the long-lived streams */
+    std::vector<std::unique_ptr<grpc::ClientContext>> stream_ctxs;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < streams; i++) {
+        stream_ctxs.emplace_back(new grpc::ClientContext);
+        grpc::ClientContext *sctx = stream_ctxs.back().get();
+        readers.emplace_back([&gw, sctx] {
+            apb::GatewayRequest req;
+            req.set_request_id("bench");
+            auto reader = gw->Stream(sctx, req);
+            apb::GatewayEvent evt;
+            while (reader->Read(&evt)) {}
+            reader->Finish();
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    /* Unary load */
+    std::vector<double> lat(calls);
+    std::atomic<int> next{0}, failed{0};
+    auto t0 = Clock::now();
+    std::vector<std::thread> workers;
+    for (int c = 0; c < clients; c++) {
+        workers.emplace_back([&] {
+            for (int i; (i = next++) < calls;) {
+                grpc::ClientContext ctx;
+                ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+                apb::ExecuteRequest req;
+                req.set_input("{}");
+                apb::ExecuteResponse resp;
+                auto s = Clock::now();
+                if (!tool->Execute(&ctx, req, &resp).ok()) failed++;
+                lat[i] = std::chrono::duration<double, std::milli>(Clock::now() - s).count();
+            }
+        });
+    }
+    for (auto &w : workers) w.join();
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    for (auto &c : stream_ctxs) c->TryCancel();
+    for (auto &r : readers) r.join();
+    kill(pid, SIGTERM);
+    waitpid(pid, nullptr, 0);
+    unlink(sock);
+
+    std::sort(lat.begin(), lat.end());
+    printf("%-9s streams=%-4d calls=%-6d  %8.0f req/s  p50 %7.2f ms  p99 %7.2f ms  failed %d\n",
+           label, streams, calls, calls / secs, lat[calls / 2], lat[calls * 99 / 100], failed.load());
+}
+
+int main(int argc, char **argv) {
+    if (argc == 4 && strcmp(argv[1], "--serve") == 0)
+        return serve((nebo_engine_t)atoi(argv[2]), atoi(argv[3]));
+
+    int streams = argc > 1 ? atoi(argv[1]) : 64;
+    int calls   = argc > 2 ? atoi(argv[2]) : 2000;
+    int clients = argc > 3 ? atoi(argv[3]) : 8;
+    int threads = argc > 4 ? atoi(argv[4]) : 4;
+
+    const char *only = argc > 5 ? argv[5] : "";
+
+    if (strcmp(only, "callback") != 0)
+        run("sync", NEBO_ENGINE_SYNC, streams, calls, clients, threads);
+    if (strcmp(only, "sync") != 0)
+        run("callback", NEBO_ENGINE_CALLBACK, streams, calls, clients, threads);
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * Gateway benchmark — token streams with and without coalescing.
+ *
+ * Forks an app whose gateway streams 1-4 byte tokens, the way upstream
+ * LLMs emit them, and opens N concurrent streams. Two loads:
+ *   burst  — every token pushed back to back: delivered tokens/s and
+ *            server CPU per token.
+ *   paced  — one token every 5 ms (200/s per stream): time to first
+ *            token, writes per stream and server CPU per token.
+ * Each load runs once with coalescing off and once with the given policy.
+ *
+ * Usage: gateway_bench [streams=128] [tokens=4000] [coalesce_bytes=256] [coalesce_ms=20]
+ *                      [sync|callback]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <grpcpp/grpcpp.h>
+
+#include "proto/apps/v0/gateway.grpc.pb.h"
+
+extern "C" {
+#include "nebo/nebo.h"
+}
+
+namespace apb = apps::v0;
+using Clock = std::chrono::steady_clock;
+
+static const char *kTokens[] = {"The", " qu", "ick", " b", "rown", " f", "ox", " j", "ump", "s", ".", "\n"};
+
+/* max_tokens is the token count; temperature the gap between tokens in ms. */
+static int bench_stream(const nebo_gateway_request_t *req, nebo_push_gateway_event_fn push, void *ctx) {
+    useconds_t gap = (useconds_t)(req->temperature * 1000);
+    for (int i = 0; i < req->max_tokens; i++) {
+        nebo_gateway_event_t evt = {"text", kTokens[i % 12], "bench", req->request_id};
+        if (push(&evt, ctx) != 0) return 0;
+        if (gap) usleep(gap);
+    }
+    nebo_gateway_event_t done = {"done", "", "bench", req->request_id};
+    push(&done, ctx);
+    return 0;
+}
+
+static int serve(nebo_engine_t engine, int coalesce_bytes, int coalesce_ms) {
+    static nebo_gateway_handler_t gw = {bench_stream, nullptr};
+    gw.coalesce_bytes = coalesce_bytes;
+    gw.coalesce_ms = coalesce_ms;
+    nebo_app_t *app = nebo_app_new();
+    nebo_app_register_gateway(app, &gw);
+    nebo_app_set_engine(app, engine, 4);
+    return nebo_app_run(app);
+}
+
+/* The server runs in a fresh exec of this binary; gRPC does not survive fork(). */
+static pid_t start_server(const char *sock, nebo_engine_t engine, int coalesce_bytes, int coalesce_ms) {
+    pid_t pid = fork();
+    if (pid != 0) return pid;
+
+    char engine_arg[16], bytes_arg[16], ms_arg[16];
+    snprintf(engine_arg, sizeof(engine_arg), "%d", (int)engine);
+    snprintf(bytes_arg, sizeof(bytes_arg), "%d", coalesce_bytes);
+    snprintf(ms_arg, sizeof(ms_arg), "%d", coalesce_ms);
+    setenv("NEBO_APP_SOCK", sock, 1);
+    setenv("NEBO_APP_NAME", "bench", 1);
+    execl("/proc/self/exe", "gateway_bench", "--serve", engine_arg, bytes_arg, ms_arg, (char *)nullptr);
+    _exit(127);
+}
+
+static void run(const char *label, nebo_engine_t engine, int coalesce_bytes, int coalesce_ms,
+                int streams, int tokens, double gap_ms) {
+    char sock[64];
+    snprintf(sock, sizeof(sock), "/tmp/nebo-gwbench-%d.sock", (int)getpid());
+    pid_t pid = start_server(sock, engine, coalesce_bytes, coalesce_ms);
+
+    auto channel = grpc::CreateChannel(std::string("unix:") + sock, grpc::InsecureChannelCredentials());
+    if (!channel->WaitForConnected(std::chrono::system_clock::now() + std::chrono::seconds(5))) {
+        fprintf(stderr, "%s: server did not start\n", label);
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+        return;
+    }
+    auto gw = apb::GatewayService::NewStub(channel);
+
+    std::vector<double> ttft(streams);
+    std::atomic<long> events{0}, bytes{0};
+    std::vector<std::thread> readers;
+    auto t0 = Clock::now();
+    for (int i = 0; i < streams; i++) {
+        readers.emplace_back([&, i] {
+            grpc::ClientContext ctx;
+            apb::GatewayRequest req;
+            req.set_request_id("bench-" + std::to_string(i));
+            req.set_max_tokens(tokens);
+            req.set_temperature(gap_ms);
+            auto s = Clock::now();
+            auto reader = gw->Stream(&ctx, req);
+            apb::GatewayEvent evt;
+            long n = 0, b = 0;
+            while (reader->Read(&evt)) {
+                if (n++ == 0) ttft[i] = std::chrono::duration<double, std::milli>(Clock::now() - s).count();
+                b += (long)evt.content().size();
+            }
+            reader->Finish();
+            events += n;
+            bytes += b;
+        });
+    }
+    for (auto &r : readers) r.join();
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    kill(pid, SIGTERM);
+    struct rusage ru;
+    int status;
+    wait4(pid, &status, 0, &ru);
+    unlink(sock);
+    double cpu_us = (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1e6 + ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+
+    long total = (long)streams * tokens, want = 0;
+    for (int i = 0; i < tokens; i++) want += (long)strlen(kTokens[i % 12]);
+    std::sort(ttft.begin(), ttft.end());
+    printf("%-10s %8.0f tok/s  TTFT p50 %6.2f ms  p99 %6.2f ms  %7.1f writes/stream  %5.2f us cpu/tok%s\n",
+           label, total / secs, ttft[streams / 2], ttft[streams * 99 / 100],
+           (double)events / streams, cpu_us / total,
+           bytes == want * streams ? "" : "  (bytes lost!)");
+}
+
+int main(int argc, char **argv) {
+    if (argc == 5 && strcmp(argv[1], "--serve") == 0)
+        return serve((nebo_engine_t)atoi(argv[2]), atoi(argv[3]), atoi(argv[4]));
+
+    int streams        = argc > 1 ? atoi(argv[1]) : 128;
+    int tokens         = argc > 2 ? atoi(argv[2]) : 4000;
+    int coalesce_bytes = argc > 3 ? atoi(argv[3]) : 256;
+    int coalesce_ms    = argc > 4 ? atoi(argv[4]) : 20;
+    nebo_engine_t engine = argc > 5 && strcmp(argv[5], "callback") == 0 ? NEBO_ENGINE_CALLBACK
+                                                                         : NEBO_ENGINE_SYNC;
+
+    run("burst off", engine, 0, 0, streams, tokens, 0);
+    run("burst on", engine, coalesce_bytes, coalesce_ms, streams, tokens, 0);
+    run("paced off", engine, 0, 0, streams, tokens / 20, 5);
+    run("paced on", engine, coalesce_bytes, coalesce_ms, streams, tokens / 20, 5);
+    return 0;
+}
@@ -0,0 +1,322 @@
+/**
+ * JSON benchmark — nebo_json_parse() vs a naive parser, and
+ * nebo_json_writer_t vs snprintf() into a fixed buffer.
+ *
+ * The naive parser is the usual byte-at-a-time recursive descent that
+ * mallocs a node per value (the shape of cJSON and most hand-rolled
+ * parsers). nebo_json_parse() runs once per available stage 1 kernel.
+ * Payloads mirror what the SDK moves:
+ *   tool-input    a calculator call (tens of bytes)
+ *   gateway       a GatewayRequest: chat history, tool_calls, tool schemas
+ *   tool-output   a 1 MB list of search results
+ * The writer cases serialize 1000 search results (strings needing escapes,
+ * integers and fractional scores), the shape of a typical tool output.
+ *
+ * Usage: json_bench [seconds-per-case=1]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+extern "C" {
+#include "nebo/json.h"
+}
+
+using Clock = std::chrono::steady_clock;
+
+/* ── Naive parser ────────────────────────────────────────────────────── */
+
+struct Node {
+    int type;
+    double number;
+    char *str;
+    Node *child;
+    Node *next;
+    char *key;
+};
+
+struct Naive {
+    const char *p;
+    const char *end;
+
+    void ws() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+    }
+
+    char *string() {
+        if (p >= end || *p != '"') return nullptr;
+        std::string out;
+        for (p++; p < end && *p != '"'; p++) {
+            if (*p != '\\') {
+                out += *p;
+                continue;
+            }
+            if (++p >= end) return nullptr;
+            switch (*p) {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u': {
+                if (end - p < 5) return nullptr;
+                unsigned cp = (unsigned)strtoul(std::string(p + 1, 4).c_str(), nullptr, 16);
+                if (cp < 0x80) out += (char)cp;
+                else if (cp < 0x800) { out += (char)(0xC0 | (cp >> 6)); out += (char)(0x80 | (cp & 0x3F)); }
+                else { out += (char)(0xE0 | (cp >> 12)); out += (char)(0x80 | ((cp >> 6) & 0x3F)); out += (char)(0x80 | (cp & 0x3F)); }
+                p += 4;
+                break;
+            }
+            default: out += *p; break;
+            }
+        }
+        if (p >= end) return nullptr;
+        p++;
+        return strdup(out.c_str());
+    }
+
+    Node *value() {
+        ws();
+        if (p >= end) return nullptr;
+        Node *n = (Node *)calloc(1, sizeof(Node));
+        if (*p == '{' || *p == '[') {
+            bool obj = *p == '{';
+            n->type = obj ? NEBO_JSON_OBJECT : NEBO_JSON_ARRAY;
+            p++;
+            ws();
+            Node **tail = &n->child;
+            if (p < end && *p == (obj ? '}' : ']')) {
+                p++;
+                return n;
+            }
+            for (;;) {
+                char *key = nullptr;
+                if (obj) {
+                    ws();
+                    if (!(key = string())) return free_node(n);
+                    ws();
+                    if (p >= end || *p++ != ':') { free(key); return free_node(n); }
+                }
+                Node *c = value();
+                if (!c) { free(key); return free_node(n); }
+                c->key = key;
+                *tail = c;
+                tail = &c->next;
+                ws();
+                if (p < end && *p == ',') { p++; continue; }
+                if (p < end && *p == (obj ? '}' : ']')) { p++; return n; }
+                return free_node(n);
+            }
+        }
+        if (*p == '"') {
+            n->type = NEBO_JSON_STRING;
+            if (!(n->str = string())) return free_node(n);
+            return n;
+        }
+        if (!strncmp(p, "true", 4))  { n->type = NEBO_JSON_TRUE;  p += 4; return n; }
+        if (!strncmp(p, "false", 5)) { n->type = NEBO_JSON_FALSE; p += 5; return n; }
+        if (!strncmp(p, "null", 4))  { n->type = NEBO_JSON_NULL;  p += 4; return n; }
+        char *e;
+        n->type = NEBO_JSON_NUMBER;
+        n->number = strtod(p, &e);
+        if (e == p) return free_node(n);
+        p = e;
+        return n;
+    }
+
+    static Node *free_node(Node *n) {
+        while (n) {
+            free_node(n->child);
+            Node *next = n->next;
+            free(n->str);
+            free(n->key);
+            free(n);
+            n = next;
+        }
+        return nullptr;
+    }
+};
+
+/* ── Payloads ────────────────────────────────────────────────────────── */
+
+static std::string tool_input() {
+    return "{\"action\":\"multiply\",\"a\":12.5,\"b\":-3e2}";
+}
+
+static std::string gateway_request() {
+    std::string s = "{\"request_id\":\"req-7f3a\",\"max_tokens\":4096,\"temperature\":0.7,"
+                    "\"system\":\"You are a helpful assistant.\\nAnswer concisely.\",\"messages\":[";
+    for (int i = 0; i < 40; i++) {
+        if (i) s += ",";
+        s += "{\"role\":\"";
+        s += i % 2 ? "assistant" : "user";
+        s += "\",\"content\":\"";
+        for (int j = 0; j < 12; j++)
+            s += "The quick brown fox jumps over the lazy dog; \\\"quoted\\\" text, a tab\\t and caf\\u00e9. ";
+        s += "\"";
+        if (i % 5 == 3) {
+            s += ",\"tool_calls\":\"[{\\\"id\\\":\\\"call_";
+            s += std::to_string(i);
+            s += "\\\",\\\"name\\\":\\\"calculator\\\",\\\"input\\\":{\\\"action\\\":\\\"add\\\",\\\"a\\\":1,\\\"b\\\":2}}]\"";
+        }
+        s += "}";
+    }
+    s += "],\"tools\":[";
+    for (int i = 0; i < 20; i++) {
+        if (i) s += ",";
+        s += "{\"name\":\"tool_" + std::to_string(i) + "\",\"description\":\"Does thing " +
+             std::to_string(i) + " for the user.\",\"input_schema\":{\"type\":\"object\",\"properties\":{"
+             "\"action\":{\"type\":\"string\",\"enum\":[\"get\",\"list\",\"create\",\"delete\"]},"
+             "\"id\":{\"type\":\"number\",\"description\":\"Record id\"},"
+             "\"query\":{\"type\":\"string\",\"description\":\"Search text\"}},\"required\":[\"action\"]}}";
+    }
+    s += "],\"user\":{\"token\":\"eyJhbGciOi.abc.def\",\"user_id\":\"u-42\",\"plan\":\"pro\"}}";
+    return s;
+}
+
+static std::string tool_output() {
+    std::string s = "{\"query\":\"nebo sdk\",\"results\":[";
+    for (int i = 0; s.size() < (1 << 20); i++) {
+        if (i) s += ",";
+        s += "{\"rank\":" + std::to_string(i) + ",\"score\":" + std::to_string(1.0 / (i + 1)) +
+             ",\"title\":\"Result number " + std::to_string(i) + "\",\"url\":\"https://example.com/a/b/" +
+             std::to_string(i) + "?q=nebo&lang=en\",\"snippet\":\"Lorem ipsum dolor sit amet, "
+             "consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore\",\"cached\":" +
+             (i % 3 ? "true" : "false") + ",\"tags\":[\"docs\",\"sdk\",null]}";
+    }
+    s += "],\"total\":1000000}";
+    return s;
+}
+
+/* ── Writers ─────────────────────────────────────────────────────────── */
+
+static const int kResults = 1000;
+
+/* The usual handler code: fixed buffer, %g, no escaping. */
+static size_t write_snprintf(char *buf, size_t cap) {
+    size_t pos = 0;
+    pos += snprintf(buf + pos, cap - pos, "{\"query\":\"nebo sdk\",\"results\":[");
+    for (int i = 0; i < kResults; i++) {
+        pos += snprintf(buf + pos, cap - pos,
+                        "%s{\"rank\":%d,\"score\":%.17g,\"title\":\"Result \\\"%d\\\"\","
+                        "\"snippet\":\"%s\",\"cached\":%s}",
+                        i ? "," : "", i, 1.0 / (i + 1), i,
+                        "Lorem ipsum dolor sit amet, consectetur adipiscing elit",
+                        i % 3 ? "true" : "false");
+    }
+    pos += snprintf(buf + pos, cap - pos, "]}");
+    return pos;
+}
+
+static size_t write_nebo(char **out) {
+    nebo_json_writer_t *w = nebo_json_writer_new(0);
+    char title[32];
+    nebo_json_write_begin_object(w);
+    nebo_json_write_key(w, "query");
+    nebo_json_write_string(w, "nebo sdk");
+    nebo_json_write_key(w, "results");
+    nebo_json_write_begin_array(w);
+    for (int i = 0; i < kResults; i++) {
+        nebo_json_write_begin_object(w);
+        nebo_json_write_key(w, "rank");
+        nebo_json_write_int(w, i);
+        nebo_json_write_key(w, "score");
+        nebo_json_write_number(w, 1.0 / (i + 1));
+        nebo_json_write_key(w, "title");
+        int n = snprintf(title, sizeof(title), "Result \"%d\"", i);
+        nebo_json_write_stringn(w, title, (size_t)n);
+        nebo_json_write_key(w, "snippet");
+        nebo_json_write_string(w, "Lorem ipsum dolor sit amet, consectetur adipiscing elit");
+        nebo_json_write_key(w, "cached");
+        nebo_json_write_bool(w, i % 3);
+        nebo_json_write_end_object(w);
+    }
+    nebo_json_write_end_array(w);
+    nebo_json_write_end_object(w);
+    size_t len = 0;
+    return nebo_json_writer_finish(w, out, &len) == 0 ? len : 0;
+}
+
+/* ── Driver ──────────────────────────────────────────────────────────── */
+
+template <class F>
+static void measure(const char *payload, const char *parser, const std::string &doc, double secs, F parse) {
+    long iters = 0;
+    auto start = Clock::now();
+    double elapsed = 0;
+    do {
+        for (int i = 0; i < 16; i++) {
+            if (!parse(doc)) {
+                printf("%-12s %-8s parse failed\n", payload, parser);
+                return;
+            }
+        }
+        iters += 16;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < secs);
+    double ns = elapsed * 1e9 / iters;
+    double mbs = doc.size() * (double)iters / elapsed / 1e6;
+    printf("%-12s %-8s %9zu bytes  %12.0f ns/doc  %9.1f MB/s\n", payload, parser, doc.size(), ns, mbs);
+}
+
+int main(int argc, char **argv) {
+    double secs = argc > 1 ? atof(argv[1]) : 1.0;
+    struct {
+        const char *name;
+        std::string doc;
+    } payloads[] = {
+        {"tool-input", tool_input()},
+        {"gateway", gateway_request()},
+        {"tool-output", tool_output()},
+    };
+    static const struct {
+        nebo_json_isa_t isa;
+        const char *name;
+    } isas[] = {
+        {NEBO_JSON_ISA_SCALAR, "scalar"},
+        {NEBO_JSON_ISA_SSE42, "sse4.2"},
+        {NEBO_JSON_ISA_AVX2, "avx2"},
+    };
+
+    for (auto &p : payloads) {
+        measure(p.name, "naive", p.doc, secs, [](const std::string &d) {
+            Naive n{d.data(), d.data() + d.size()};
+            Node *root = n.value();
+            if (!root) return false;
+            Naive::free_node(root);
+            return true;
+        });
+        for (auto &isa : isas) {
+            if (nebo_json_set_isa(isa.isa) != 0) {
+                printf("%-12s %-8s unsupported on this CPU\n", p.name, isa.name);
+                continue;
+            }
+            measure(p.name, isa.name, p.doc, secs, [](const std::string &d) {
+                nebo_json_doc_t *doc = nebo_json_parse(d.data(), d.size(), nullptr, 0);
+                if (!doc) return false;
+                nebo_json_free(doc);
+                return true;
+            });
+        }
+    }
+    nebo_json_set_isa(NEBO_JSON_ISA_AUTO);
+
+    /* Writers: measure() wants a document; size it from the output. */
+    char *sample = nullptr;
+    std::string results(write_nebo(&sample), ' ');
+    free(sample);
+    static char fixed[1 << 20];
+    measure("write", "snprintf", results, secs, [](const std::string &) {
+        return write_snprintf(fixed, sizeof(fixed)) > 0;
+    });
+    measure("write", "nebo", results, secs, [](const std::string &) {
+        char *out = nullptr;
+        size_t len = write_nebo(&out);
+        free(out);
+        return len > 0;
+    });
+    return 0;
+}
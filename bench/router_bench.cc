@@ -0,0 +1,131 @@
+/**
+ * Router benchmark — match request paths against an API of 64 routes with
+ * nebo_router_t vs a linear scan that tries each pattern in turn.
+ *
+ * The linear scan is what a handle_request strcmp chain amounts to once it
+ * has params: compare segment by segment, route after route, until one
+ * fits. Both see the same routes and the same mix of paths, spread across
+ * the table so the scan's average is its middle.
+ *
+ * Usage: router_bench [seconds-per-case=1]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "nebo/router.h"
+}
+
+using Clock = std::chrono::steady_clock;
+
+static const char *kResources[] = {
+    "users", "teams", "projects", "issues", "comments", "labels", "milestones", "releases",
+};
+
+struct Route {
+    std::string method;
+    std::string pattern;
+};
+
+/* Eight resources, each with the usual eight routes. */
+static std::vector<Route> api() {
+    std::vector<Route> routes;
+    for (const char *r : kResources) {
+        std::string base = std::string("/api/v1/") + r;
+        routes.push_back({"GET", base});
+        routes.push_back({"POST", base});
+        routes.push_back({"GET", base + "/search"});
+        routes.push_back({"GET", base + "/:id"});
+        routes.push_back({"PUT", base + "/:id"});
+        routes.push_back({"DELETE", base + "/:id"});
+        routes.push_back({"GET", base + "/:id/history"});
+        routes.push_back({"GET", base + "/:id/members/:member"});
+    }
+    return routes;
+}
+
+static int handler(const nebo_http_request_t *, const nebo_route_match_t *, nebo_http_response_t *) {
+    return 0;
+}
+
+/* ── Linear scan ─────────────────────────────────────────────────────── */
+
+static bool match_pattern(const char *pat, const char *path, nebo_route_match_t *m) {
+    m->param_count = 0;
+    while (*pat && *path) {
+        if (*pat == ':') {
+            const char *name = ++pat;
+            while (*pat && *pat != '/') pat++;
+            const char *v = path;
+            while (*path && *path != '/') path++;
+            if (path == v) return false;
+            m->params[m->param_count++] = {name, v, (size_t)(path - v)};
+        } else if (*pat++ != *path++) {
+            return false;
+        }
+    }
+    return !*pat && !*path;
+}
+
+static int linear(const std::vector<Route> &routes, const char *method, const char *path,
+                  nebo_route_match_t *m) {
+    for (size_t i = 0; i < routes.size(); i++) {
+        if (routes[i].method == method && match_pattern(routes[i].pattern.c_str(), path, m))
+            return (int)i;
+    }
+    return -1;
+}
+
+/* ── Driver ──────────────────────────────────────────────────────────── */
+
+template <class F>
+static void measure(const char *name, size_t n, double secs, F match) {
+    long iters = 0;
+    auto start = Clock::now();
+    double elapsed = 0;
+    size_t next = 0;
+    int sink = 0;
+    do {
+        for (int i = 0; i < 1024; i++) sink += match(next++ % n);
+        iters += 1024;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < secs);
+    printf("%-8s %3zu paths  %8.1f ns/match  (%d)\n", name, n, elapsed * 1e9 / iters, sink & 1);
+}
+
+int main(int argc, char **argv) {
+    double secs = argc > 1 ? atof(argv[1]) : 1.0;
+    std::vector<Route> routes = api();
+    nebo_router_t *r = nebo_router_new();
+    for (const Route &rt : routes) nebo_router_add(r, rt.method.c_str(), rt.pattern.c_str(), handler, nullptr);
+
+    struct Req {
+        const char *method;
+        std::string path;
+    };
+    std::vector<Req> reqs;
+    for (const char *res : kResources) {
+        std::string base = std::string("/api/v1/") + res;
+        reqs.push_back({"GET", base});
+        reqs.push_back({"GET", base + "/search"});
+        reqs.push_back({"GET", base + "/1234"});
+        reqs.push_back({"DELETE", base + "/1234"});
+        reqs.push_back({"GET", base + "/1234/members/99"});
+    }
+
+    measure("linear", reqs.size(), secs, [&](size_t i) {
+        nebo_route_match_t m;
+        return linear(routes, reqs[i].method, reqs[i].path.c_str(), &m);
+    });
+    measure("router", reqs.size(), secs, [&](size_t i) {
+        nebo_route_match_t m;
+        return nebo_router_match(r, reqs[i].method, reqs[i].path.c_str(), &m, nullptr) ? 1 : 0;
+    });
+    nebo_router_free(r);
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * Tool I/O benchmark — execute (copying) vs execute_buf (zero-copy).
+ *
+ * Forks an app whose tool echoes its input back. The legacy handler takes
+ * the NUL-terminated input and strdup()s its output, as handlers do today;
+ * the buffer handler writes the input straight into the SDK output sink.
+ * Reports mean round-trip time per Execute at 1 KB, 1 MB and 16 MB.
+ *
+ * Usage: tool_io_bench [iterations=20]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <grpcpp/grpcpp.h>
+
+#include "proto/apps/v0/tool.grpc.pb.h"
+
+extern "C" {
+#include "nebo/nebo.h"
+}
+
+namespace apb = apps::v0;
+using Clock = std::chrono::steady_clock;
+
+static int echo_execute(const char *input_json, char **output, int *is_error) {
+    *output = strdup(input_json);
+    *is_error = 0;
+    return 0;
+}
+
+static int echo_execute_buf(const char *input_json, size_t len, nebo_tool_output_t *out) {
+    nebo_tool_output_write(out, input_json, len);
+    return 0;
+}
+
+static int serve(int zero_copy) {
+    static nebo_tool_handler_t tool = {"echo", "echo tool", "{}", echo_execute, nullptr, nullptr, nullptr};
+    if (zero_copy) tool.execute_buf = echo_execute_buf;
+    nebo_app_t *app = nebo_app_new();
+    nebo_app_register_tool(app, &tool);
+    return nebo_app_run(app);
+}
+
+/* The server runs in a fresh exec of this binary; gRPC does not survive fork(). */
+static pid_t start_server(const char *sock, int zero_copy) {
+    pid_t pid = fork();
+    if (pid != 0) return pid;
+    setenv("NEBO_APP_SOCK", sock, 1);
+    setenv("NEBO_APP_NAME", "bench", 1);
+    execl("/proc/self/exe", "tool_io_bench", "--serve", zero_copy ? "1" : "0", (char *)nullptr);
+    _exit(127);
+}
+
+static void run(const char *label, int zero_copy, int iterations) {
+    static const size_t sizes[] = {1 << 10, 1 << 20, 16 << 20};
+    char sock[64];
+    snprintf(sock, sizeof(sock), "/tmp/nebo-bench-%d.sock", (int)getpid());
+    pid_t pid = start_server(sock, zero_copy);
+
+    grpc::ChannelArguments args;
+    args.SetMaxReceiveMessageSize(-1);
+    auto channel = grpc::CreateCustomChannel(std::string("unix:") + sock,
+                                             grpc::InsecureChannelCredentials(), args);
+    if (!channel->WaitForConnected(std::chrono::system_clock::now() + std::chrono::seconds(5))) {
+        fprintf(stderr, "%s: server did not start\n", label);
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+        return;
+    }
+    auto tool = apb::ToolService::NewStub(channel);
+
+    for (size_t size : sizes) {
+        apb::ExecuteRequest req;
+        std::string input(size, 'x');
+        input.front() = '"';
+        input.back() = '"';
+        req.set_input(input);
+
+        double total = 0;
+        int failed = 0;
+        for (int i = 0; i < iterations; i++) {
+            grpc::ClientContext ctx;
+            apb::ExecuteResponse resp;
+            auto s = Clock::now();
+            grpc::Status st = tool->Execute(&ctx, req, &resp);
+            total += std::chrono::duration<double, std::milli>(Clock::now() - s).count();
+            if (!st.ok() || resp.content().size() != size) failed++;
+        }
+        printf("%-7s %9zu bytes  %9.3f ms/call  failed %d\n", label, size, total / iterations, failed);
+    }
+
+    kill(pid, SIGTERM);
+    waitpid(pid, nullptr, 0);
+    unlink(sock);
+}
+
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "--serve") == 0) return serve(atoi(argv[2]));
+
+    int iterations = argc > 1 ? atoi(argv[1]) : 20;
+    run("copy", 0, iterations);
+    run("buffer", 1, iterations);
+    return 0;
+}
@@ -0,0 +1,248 @@
+/**
+ * View builder benchmark — build and free a dashboard with the arena-backed
+ * nebo_view_builder_t vs a builder that strdup()s every field.
+ *
+ * The strdup builder is the shape the SDK shipped before: one malloc per
+ * string (block types included) and one free per string on release. Both
+ * build the same dashboard: a heading, then rows of text, toggle, select
+ * and button blocks, the kind of view an app rebuilds on every UI event.
+ *
+ * The diff cases flip one toggle in that dashboard and serialize the update
+ * to JSON twice: as a full render (a diff against no view) and as the patch
+ * from the previous view.
+ *
+ * The session cases give each session its own variant of the dashboard
+ * (one toggle flipped): rebuilt from scratch, or derived from one shared
+ * view.
+ *
+ * The render cases re-render that dashboard with a different toggle
+ * flipped each time, with and without a nebo_view_renderer_t.
+ *
+ * Usage: view_bench [seconds-per-case=1]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+extern "C" {
+#include "nebo/view.h"
+}
+
+using Clock = std::chrono::steady_clock;
+
+static const nebo_select_option_t kOptions[] = {
+    {"Daily", "daily"}, {"Weekly", "weekly"}, {"Monthly", "monthly"},
+};
+
+/* ── strdup builder ──────────────────────────────────────────────────── */
+
+struct StrdupView {
+    char *view_id;
+    char *title;
+    nebo_ui_block_t *blocks;
+    int count;
+    int cap;
+};
+
+static nebo_ui_block_t *strdup_add(StrdupView *v, const char *type, const char *id) {
+    if (v->count == v->cap) {
+        v->cap = v->cap ? v->cap * 2 : 16;
+        v->blocks = (nebo_ui_block_t *)realloc(v->blocks, v->cap * sizeof(nebo_ui_block_t));
+    }
+    nebo_ui_block_t *b = &v->blocks[v->count++];
+    memset(b, 0, sizeof(*b));
+    b->type = strdup(type);
+    b->block_id = strdup(id);
+    return b;
+}
+
+static void strdup_free(StrdupView *v) {
+    for (int i = 0; i < v->count; i++) {
+        nebo_ui_block_t *b = &v->blocks[i];
+        free((void *)b->block_id);
+        free((void *)b->type);
+        free((void *)b->text);
+        free((void *)b->value);
+        free((void *)b->variant);
+        for (int j = 0; j < b->options_count; j++) {
+            free((void *)b->options[j].label);
+            free((void *)b->options[j].value);
+        }
+        free((void *)b->options);
+    }
+    free(v->blocks);
+    free(v->view_id);
+    free(v->title);
+}
+
+static int build_strdup(int rows) {
+    StrdupView v = {strdup("dash"), strdup("Dashboard"), nullptr, 0, 0};
+    char id[32], text[64];
+    nebo_ui_block_t *b = strdup_add(&v, "heading", "title");
+    b->text = strdup("Overview");
+    b->variant = strdup("h1");
+    for (int i = 0; i < rows; i++) {
+        snprintf(text, sizeof(text), "Service %d is healthy", i);
+        snprintf(id, sizeof(id), "status-%d", i);
+        strdup_add(&v, "text", id)->text = strdup(text);
+        snprintf(id, sizeof(id), "alerts-%d", i);
+        b = strdup_add(&v, "toggle", id);
+        b->text = strdup("Alerts");
+        b->value = strdup(i & 1 ? "true" : "false");
+        snprintf(id, sizeof(id), "period-%d", i);
+        b = strdup_add(&v, "select", id);
+        b->value = strdup("weekly");
+        b->options = (nebo_select_option_t *)calloc(3, sizeof(nebo_select_option_t));
+        for (int j = 0; j < 3; j++) {
+            ((nebo_select_option_t *)b->options)[j].label = strdup(kOptions[j].label);
+            ((nebo_select_option_t *)b->options)[j].value = strdup(kOptions[j].value);
+        }
+        b->options_count = 3;
+        snprintf(id, sizeof(id), "restart-%d", i);
+        b = strdup_add(&v, "button", id);
+        b->text = strdup("Restart");
+        b->variant = strdup("secondary");
+    }
+    int n = v.count;
+    strdup_free(&v);
+    return n;
+}
+
+/* ── nebo builder ────────────────────────────────────────────────────── */
+
+static nebo_ui_view_t *dashboard(int rows, int flipped) {
+    nebo_view_builder_t *vb = nebo_view_new("dash", "Dashboard");
+    char id[32], text[64];
+    nebo_view_heading(vb, "title", "Overview", "h1");
+    for (int i = 0; i < rows; i++) {
+        snprintf(text, sizeof(text), "Service %d is healthy", i);
+        snprintf(id, sizeof(id), "status-%d", i);
+        nebo_view_text(vb, id, text);
+        snprintf(id, sizeof(id), "alerts-%d", i);
+        nebo_view_toggle(vb, id, "Alerts", (i & 1) ^ (i == flipped));
+        snprintf(id, sizeof(id), "period-%d", i);
+        nebo_view_select(vb, id, "weekly", kOptions, 3);
+        snprintf(id, sizeof(id), "restart-%d", i);
+        nebo_view_button(vb, id, "Restart", "secondary");
+    }
+    nebo_ui_view_t *view = nebo_view_build(vb);
+    nebo_view_free(vb);
+    return view;
+}
+
+static int build_nebo(int rows) {
+    nebo_ui_view_t *view = dashboard(rows, -1);
+    if (!view) return 0;
+    int n = view->block_count;
+    nebo_view_free_view(view);
+    return n;
+}
+
+/** Diff and serialize; returns the JSON size. */
+static size_t patch_json(const nebo_ui_view_t *old_view, const nebo_ui_view_t *new_view) {
+    nebo_view_patch_t *patch = nebo_view_diff(old_view, new_view);
+    nebo_json_writer_t *w = nebo_json_writer_new(0);
+    nebo_view_patch_write_json(patch, w);
+    size_t len = 0;
+    nebo_json_writer_data(w, &len);
+    nebo_json_writer_free(w);
+    nebo_view_patch_free(patch);
+    return len;
+}
+
+/* ── Driver ──────────────────────────────────────────────────────────── */
+
+template <class F>
+static void measure(const char *name, int rows, double secs, F build) {
+    long iters = 0;
+    int blocks = 0;
+    auto start = Clock::now();
+    double elapsed = 0;
+    do {
+        for (int i = 0; i < 16; i++) blocks = build(rows);
+        iters += 16;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < secs);
+    double ns = elapsed * 1e9 / iters;
+    printf("%-8s %6d blocks  %12.0f ns/view  %8.1f ns/block\n", name, blocks, ns, ns / blocks);
+}
+
+template <class F>
+static void measure_diff(const char *name, int rows, double secs, F run, const size_t *bytes) {
+    long iters = 0;
+    auto start = Clock::now();
+    double elapsed = 0;
+    do {
+        for (int i = 0; i < 16; i++) run();
+        iters += 16;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < secs);
+    printf("%-8s %6d blocks  %12.0f ns/update  %8zu bytes\n", name, 1 + rows * 4,
+           elapsed * 1e9 / iters, *bytes);
+}
+
+int main(int argc, char **argv) {
+    double secs = argc > 1 ? atof(argv[1]) : 1.0;
+    static const int rows_cases[] = {4, 64, 1024};
+    for (int rows : rows_cases) {
+        measure("strdup", rows, secs, build_strdup);
+        measure("nebo", rows, secs, build_nebo);
+    }
+    for (int rows : rows_cases) {
+        nebo_ui_view_t *shared = dashboard(rows, -1);
+        measure("rebuild", rows, secs, [](int r) {
+            nebo_ui_view_t *view = dashboard(r, r / 2);
+            int n = view->block_count;
+            nebo_view_free_view(view);
+            return n;
+        });
+        measure("derive", rows, secs, [shared](int r) {
+            char id[32];
+            snprintf(id, sizeof(id), "alerts-%d", r / 2);
+            nebo_ui_block_t b = *nebo_view_find(shared, id);
+            b.value = "true";
+            nebo_ui_view_t *view = nebo_view_derive(shared, id, &b);
+            int n = view->block_count;
+            nebo_view_free_view(view);
+            return n;
+        });
+        nebo_view_free_view(shared);
+    }
+    for (int rows : rows_cases) {
+        nebo_ui_view_t *before = dashboard(rows, -1);
+        nebo_ui_view_t *after = dashboard(rows, rows / 2);
+        size_t bytes = 0;
+        measure_diff("full", rows, secs, [&] { return bytes = patch_json(nullptr, after); }, &bytes);
+        measure_diff("patch", rows, secs, [&] { return bytes = patch_json(before, after); }, &bytes);
+        nebo_view_free_view(before);
+        nebo_view_free_view(after);
+    }
+    for (int rows : rows_cases) {
+        nebo_ui_view_t *views[8];
+        for (int i = 0; i < 8; i++) views[i] = dashboard(rows, i);
+        nebo_view_renderer_t *r = nebo_view_renderer_new(0);
+        int next = 0;
+        for (nebo_view_renderer_t *cache : {(nebo_view_renderer_t *)nullptr, r}) {
+            measure(cache ? "json-hit" : "json", rows, secs, [&](int) {
+                nebo_ui_view_t *v = views[next++ & 7];
+                nebo_json_writer_t *w = nebo_json_writer_new(0);
+                nebo_view_render_json(cache, v, w);
+                nebo_json_writer_free(w);
+                return v->block_count;
+            });
+            measure(cache ? "html-hit" : "html", rows, secs, [&](int) {
+                nebo_ui_view_t *v = views[next++ & 7];
+                char *html = nullptr;
+                nebo_view_render_html(cache, v, &html, nullptr);
+                free(html);
+                return v->block_count;
+            });
+        }
+        nebo_view_renderer_free(r);
+        for (nebo_ui_view_t *v : views) nebo_view_free_view(v);
+    }
+    return 0;
+}
@@ -5,43 +5,13 @@
 #include <nebo/nebo.h>
 
 /*
- * Simple JSON parsing helpers for the calculator.
- * In a real app, use a JSON library (cJSON, jansson, etc.).
+ * The SDK validates input against the compiled schema before calling us,
+ * so action is one of the declared actions and a, b are numbers.
  */
-static double json_get_number(const char *json, const char *key) {
-    char pattern[64];
-    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
-    const char *p = strstr(json, pattern);
-    if (!p) return 0;
-    p += strlen(pattern);
-    while (*p == ' ') p++;
-    return atof(p);
-}
-
-static int json_get_string(const char *json, const char *key, char *out, int maxlen) {
-    char pattern[64];
-    snprintf(pattern, sizeof(pattern), "\"%s\":\"", key);
-    const char *p = strstr(json, pattern);
-    if (!p) return -1;
-    p += strlen(pattern);
-    int i = 0;
-    while (*p && *p != '"' && i < maxlen - 1) {
-        out[i++] = *p++;
-    }
-    out[i] = '\0';
-    return 0;
-}
-
-static int calculator_execute(const char *input_json, char **output, int *is_error) {
-    char action[32] = {0};
-    if (json_get_string(input_json, "action", action, sizeof(action)) != 0) {
-        *output = strdup("Missing action");
-        *is_error = 1;
-        return 0;
-    }
-
-    double a = json_get_number(input_json, "a");
-    double b = json_get_number(input_json, "b");
+static int calculator_execute(const nebo_input_t *in, char **output, int *is_error) {
+    const char *action = nebo_input_action(in);
+    double a = nebo_input_get_number(in, "a");
+    double b = nebo_input_get_number(in, "b");
     double result = 0;
 
     if (strcmp(action, "add") == 0) {
@@ -50,19 +20,13 @@ static int calculator_execute(const char *input_json, char **output, int *is_err
         result = a - b;
     } else if (strcmp(action, "multiply") == 0) {
         result = a * b;
-    } else if (strcmp(action, "divide") == 0) {
+    } else {
         if (b == 0) {
             *output = strdup("Division by zero");
             *is_error = 1;
             return 0;
         }
         result = a / b;
-    } else {
-        char buf[128];
-        snprintf(buf, sizeof(buf), "Unknown action: %s", action);
-        *output = strdup(buf);
-        *is_error = 1;
-        return 0;
     }
 
     char buf[256];
@@ -79,20 +43,24 @@ int main(void) {
     nebo_schema_number(sb, "a", "First operand", 1);
     nebo_schema_number(sb, "b", "Second operand", 1);
     char *schema = nebo_schema_build(sb);
+    nebo_validator_t *validator = nebo_schema_compile(sb);
     nebo_schema_free(sb);
 
     nebo_tool_handler_t calculator = {
         .name = "calculator",
         .description = "Performs arithmetic calculations.",
         .schema = schema,
-        .execute = calculator_execute,
         .requires_approval = NULL,
+        .cache = 1, /* pure arithmetic: same input, same answer */
+        .validator = validator,
+        .execute_input = calculator_execute,
     };
 
     nebo_app_t *app = nebo_app_new();
     nebo_app_register_tool(app, &calculator);
     int ret = nebo_app_run(app);
 
+    nebo_validator_free(validator);
     free(schema);
     return ret;
 }
@@ -0,0 +1,54 @@
+#ifndef NEBO_CALL_H
+#define NEBO_CALL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Per-call context: the host's deadline and cancellation for the RPC a
+ * handler is serving.
+ *
+ * Every handler the SDK invokes (tool executes, UI requests, schedule
+ * triggers, channel and comm sends, ...) runs with a current call, returned
+ * by nebo_call_current() on the handler's thread until the handler returns.
+ * Once the host times out or hangs up, nobody reads the result: handlers
+ * doing real work should check nebo_call_is_cancelled() between steps, or
+ * register nebo_call_on_cancel(), and give up early.
+ *
+ *   for (size_t i = 0; i < n; i++) {
+ *       if (nebo_call_is_cancelled(nebo_call_current())) return 1;
+ *       work(i);
+ *   }
+ *
+ * Async tool handlers keep using the call after execute_async() returns via
+ * nebo_tool_completion_call().
+ */
+
+typedef struct nebo_call nebo_call_t;
+
+/** The call the current thread's handler is serving, or NULL outside a handler. */
+nebo_call_t *nebo_call_current(void);
+
+/** Milliseconds left before the host's deadline: -1 if it set none, 0 once passed. */
+long long nebo_call_deadline_ms(const nebo_call_t *call);
+
+/** 1 if the host cancelled the call or its deadline passed, else 0. NULL gives 0. */
+int nebo_call_is_cancelled(const nebo_call_t *call);
+
+typedef void (*nebo_call_cancel_fn)(void *user_data);
+
+/**
+ * Ask to be told when the call is cancelled. fn runs at most once, on an SDK
+ * thread, within a few milliseconds of the cancellation or deadline, and
+ * never after the handler has returned (for async tools: after the call
+ * completed). Use it to interrupt a blocking wait. A second registration
+ * replaces the first; fn = NULL removes it. Returns 0, or -1 if call is NULL.
+ */
+int nebo_call_on_cancel(nebo_call_t *call, nebo_call_cancel_fn fn, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NEBO_CALL_H */
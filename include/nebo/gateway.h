@@ -7,6 +7,13 @@
 extern "C" {
 #endif
 
+/** What push() does when a stream's write queue is full. */
+typedef enum {
+    NEBO_BACKPRESSURE_BLOCK = 0,    /* wait for the host to catch up */
+    NEBO_BACKPRESSURE_DROP_OLDEST,  /* drop the oldest queued "thinking" event; else wait */
+    NEBO_BACKPRESSURE_FAIL          /* refuse the event: push() returns non-zero */
+} nebo_backpressure_t;
+
 /**
  * Gateway handler — implement this to provide LLM model routing.
  *
@@ -15,15 +22,82 @@ extern "C" {
  *         tool_call, thinking, error, done). Return 0 when done, non-zero on
  *         fatal error. push() returns non-zero if the stream was cancelled.
  *
- * cancel: Called to abort an in-progress stream. Return 0 on success.
+ * cancel: Optional. Called to abort an in-progress stream. Return 0 on
+ *         success.
+ *
+ * The SDK tracks streamed requests by request_id. GatewayService.Cancel, or
+ * the host hanging up, makes the stream's next push() fail and runs the
+ * callback the stream registered with nebo_call_on_cancel(): at once for
+ * Cancel, within a few milliseconds for a hang-up. A handler can close its
+ * upstream connection there without keeping its own map of requests:
+ *
+ *   static void stop(void *conn) { upstream_close(conn); }
+ *   ...
+ *   nebo_call_on_cancel(nebo_call_current(), stop, conn);
+ *
+ * Requests with poll set are for hosts that poll instead of holding the
+ * stream open: stream runs on its own thread and its events are buffered
+ * for GatewayService.Poll, which drains them in batches. push() blocks
+ * while poll_capacity events wait undrained, and fails once the request is
+ * cancelled, nobody polled it for poll_ttl_ms, or a Poll returned its
+ * "done". Its current call has no deadline (the Stream RPC has already
+ * returned) and is cancelled in those same cases, so nebo_call_on_cancel()
+ * works there too.
+ *
+ * Set coalesce_bytes to merge consecutive "text" (or "thinking") events of
+ * a streamed request into one event of up to that many bytes, written at
+ * the latest coalesce_ms after its first token. A token arriving after
+ * coalesce_ms without a write is sent at once, so time to first token is
+ * unchanged. Any other event type goes out after the batch before it, so
+ * order is kept. A host hanging up is then noticed by push() up to
+ * coalesce_ms late; Cancel is noticed at once. A coalescing stream always
+ * writes through a write queue (of 64 events unless write_queue is set):
+ * a batch left behind by a quiet handler is handed to the stream's writer
+ * thread, so a slow host never delays the batches of other streams.
+ *
+ * Set write_queue to decouple push() from the host: events of a streamed
+ * request go into a queue of that many events, and a writer thread of the
+ * stream sends them, so a slow host does not stall the handler's upstream
+ * reads until the queue fills. write_backpressure picks what push() does
+ * then. Events still queued when stream returns are sent before the call
+ * ends.
  */
 typedef struct {
     int (*stream)(const nebo_gateway_request_t *req,
                   nebo_push_gateway_event_fn push,
                   void *stream_ctx);
     int (*cancel)(const char *request_id);
+    int poll_capacity; /* optional, events buffered per polled request; 0 = 1024 */
+    int poll_ttl_ms;   /* optional, reap a polled request idle this long; 0 = 30000 */
+    int coalesce_bytes; /* optional, merge text/thinking tokens up to this size; 0 = off */
+    int coalesce_ms;    /* optional, longest a token waits to be merged; 0 = 20 */
+    int write_queue;    /* optional, events queued per stream for its writer; 0 = write in push() */
+    nebo_backpressure_t write_backpressure;
 } nebo_gateway_handler_t;
 
+/**
+ * Write-queue counters of one stream of a handler with write_queue or
+ * coalesce_bytes set.
+ */
+typedef struct {
+    int depth;                        /* events queued now */
+    int high_water;                   /* most events queued at once */
+    unsigned long long written;
+    unsigned long long dropped;       /* dropped or refused by the backpressure policy */
+    unsigned long long stalls;        /* push() calls that waited for room */
+    unsigned long long stall_us;      /* total time push() waited */
+    unsigned long long write_us_max;  /* slowest single write to the host */
+} nebo_gateway_stream_stats_t;
+
+/**
+ * Read the write-queue counters of a stream in progress, e.g. from its own
+ * handler just before it returns. Safe from any thread. Returns 0 on
+ * success, -1 if no queued stream of gw has that request_id, or if more
+ * than one live stream does.
+ */
+int nebo_gateway_stream_stats(const nebo_gateway_handler_t *gw, const char *request_id,
+                              nebo_gateway_stream_stats_t *out);
+
 #ifdef __cplusplus
 }
 #endif
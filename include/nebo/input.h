@@ -0,0 +1,76 @@
+#ifndef NEBO_INPUT_H
+#define NEBO_INPUT_H
+
+#include <stddef.h>
+
+#include "schema.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Compiled input validator and typed input view.
+ *
+ * nebo_schema_compile() turns a schema builder into a validator. Validating
+ * a tool input checks it in one pass — JSON syntax, the action enum,
+ * declared property types and enums, required properties — and yields a
+ * typed view with O(1) lookups by property name. Strings in the view are
+ * unescaped and NUL-terminated; everything lives in one arena owned by
+ * the view, so nothing in it points into the parsed buffer.
+ *
+ * Set the validator on a nebo_tool_handler_t and the SDK rejects invalid
+ * input before the handler runs; execute_input then receives the view.
+ */
+
+typedef struct nebo_validator nebo_validator_t;
+typedef struct nebo_input nebo_input_t;
+
+/**
+ * Compile the builder's action list and properties into a validator.
+ * The validator does not reference the builder afterwards. Returns NULL on
+ * OOM. Free with nebo_validator_free().
+ */
+nebo_validator_t *nebo_schema_compile(const nebo_schema_builder_t *b);
+
+/** Free a validator. Safe to call with NULL. */
+void nebo_validator_free(nebo_validator_t *v);
+
+/**
+ * Validate len bytes of JSON against v and index them. Returns NULL if the
+ * input is invalid, writing a reason of at most errlen bytes (including the
+ * NUL) into err when err is non-NULL. Free the result with nebo_input_free().
+ */
+nebo_input_t *nebo_input_parse(const nebo_validator_t *v, const char *json, size_t len,
+                               char *err, size_t errlen);
+
+/** Free a typed input view. Safe to call with NULL. */
+void nebo_input_free(nebo_input_t *in);
+
+/** The validated "action" value, or NULL if the schema declares no actions. */
+const char *nebo_input_action(const nebo_input_t *in);
+
+/** 1 if the property was present in the input, 0 otherwise. */
+int nebo_input_has(const nebo_input_t *in, const char *name);
+
+/** Number property, or 0 if absent or not a declared number. */
+double nebo_input_get_number(const nebo_input_t *in, const char *name);
+
+/** String or enum property, or NULL if absent. len (optional) receives its length. */
+const char *nebo_input_get_string(const nebo_input_t *in, const char *name, size_t *len);
+
+/** Boolean property, or 0 if absent. */
+int nebo_input_get_bool(const nebo_input_t *in, const char *name);
+
+/**
+ * Raw JSON text of an object property, NUL-terminated, or NULL if absent.
+ * Like every string of the view it is a copy in the view's arena, valid
+ * until nebo_input_free() even after the parsed buffer is gone.
+ */
+const char *nebo_input_get_raw(const nebo_input_t *in, const char *name, size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NEBO_INPUT_H */
@@ -0,0 +1,184 @@
+#ifndef NEBO_JSON_H
+#define NEBO_JSON_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * JSON parser — dependency-free, SIMD-accelerated.
+ *
+ * Parsing runs in two passes. Stage 1 scans the input 64 bytes at a time
+ * (AVX2, SSE4.2 or portable scalar code, picked at runtime) and marks every
+ * structural character, string quote and the start of every number or
+ * literal. Stage 2 walks only those positions, checks the grammar and writes
+ * a flat tape of values. Strings are unescaped and numbers copied into the
+ * document, so the input may be freed once nebo_json_parse() returns.
+ * Numbers are converted to double only when read.
+ *
+ * Values are small handles into the document's tape, valid until
+ * nebo_json_free(). Lookups on a missing key or index return an invalid
+ * handle (type NEBO_JSON_INVALID). Every accessor accepts one, so lookups
+ * chain without checks: nebo_json_get(nebo_json_get(root, "user"), "id").
+ */
+
+typedef struct nebo_json_doc nebo_json_doc_t;
+
+typedef struct {
+    const nebo_json_doc_t *doc; /* NULL = invalid */
+    size_t idx;
+} nebo_json_t;
+
+typedef enum {
+    NEBO_JSON_INVALID = 0,
+    NEBO_JSON_NULL,
+    NEBO_JSON_FALSE,
+    NEBO_JSON_TRUE,
+    NEBO_JSON_NUMBER,
+    NEBO_JSON_STRING,
+    NEBO_JSON_ARRAY,
+    NEBO_JSON_OBJECT
+} nebo_json_type_t;
+
+/** Stage 1 implementations. AUTO picks the widest one the CPU supports. */
+typedef enum {
+    NEBO_JSON_ISA_AUTO = 0,
+    NEBO_JSON_ISA_SCALAR,
+    NEBO_JSON_ISA_SSE42,
+    NEBO_JSON_ISA_AVX2
+} nebo_json_isa_t;
+
+/**
+ * Parse len bytes of JSON. Returns NULL on invalid input, writing a reason
+ * of at most errlen bytes (including the NUL) into err when err is non-NULL.
+ * Free the document with nebo_json_free().
+ */
+nebo_json_doc_t *nebo_json_parse(const char *json, size_t len, char *err, size_t errlen);
+
+/** Free a document and everything it owns. Safe to call with NULL. */
+void nebo_json_free(nebo_json_doc_t *doc);
+
+/** The top-level value. */
+nebo_json_t nebo_json_root(const nebo_json_doc_t *doc);
+
+nebo_json_type_t nebo_json_type(nebo_json_t v);
+
+/** Number value, or 0 if v is not a number. */
+double nebo_json_number(nebo_json_t v);
+
+/**
+ * Unescaped, NUL-terminated string value, or NULL if v is not a string.
+ * len (optional) receives the length, which counts embedded NULs.
+ */
+const char *nebo_json_string(nebo_json_t v, size_t *len);
+
+/** 1 for true, 0 for anything else. */
+int nebo_json_bool(nebo_json_t v);
+
+/** Element count of an array or member count of an object; 0 otherwise. */
+size_t nebo_json_size(nebo_json_t v);
+
+/** Member of an object by key. Linear in the member count. */
+nebo_json_t nebo_json_get(nebo_json_t obj, const char *key);
+
+/** Element of an array by index. Linear in the index. */
+nebo_json_t nebo_json_at(nebo_json_t arr, size_t i);
+
+/**
+ * Iteration: the first element (or member value) of a container, then each
+ * following one, until an invalid handle.
+ *
+ *   for (nebo_json_t m = nebo_json_first(obj); m.doc; m = nebo_json_next(m))
+ *       printf("%s\n", nebo_json_key(m, NULL));
+ */
+nebo_json_t nebo_json_first(nebo_json_t container);
+nebo_json_t nebo_json_next(nebo_json_t v);
+
+/** Key of an object member value, or NULL if v is not one. */
+const char *nebo_json_key(nebo_json_t v, size_t *len);
+
+/**
+ * Select the stage 1 implementation for this process. For benchmarks and
+ * tests: call it before parsing starts (parses already running may still
+ * use the previous one). Returns -1 if the CPU lacks the instruction set.
+ * Without it, the first parse picks the best one the CPU supports.
+ */
+int nebo_json_set_isa(nebo_json_isa_t isa);
+
+/** Name of the stage 1 implementation in use: "avx2", "sse4.2" or "scalar". */
+const char *nebo_json_isa_name(void);
+
+/* ── Writer ──────────────────────────────────────────────────────────── */
+
+/**
+ * Streaming JSON writer. Values are appended in document order into one
+ * growable buffer. Strings are escaped; doubles are printed in the fewest
+ * digits that read back to the same value, so 0.1 is "0.1".
+ * NaN and infinities, which JSON cannot represent, are written as null.
+ *
+ * Write calls never fail individually: running out of memory or misusing
+ * the writer (a key outside an object, a second top-level value, an
+ * unclosed container) is remembered and reported by
+ * nebo_json_writer_finish(), so handlers check once at the end:
+ *
+ *   nebo_json_writer_t *w = nebo_json_writer_new(0);
+ *   nebo_json_write_begin_object(w);
+ *   nebo_json_write_key(w, "result");
+ *   nebo_json_write_number(w, 0.1 + 0.2);
+ *   nebo_json_write_end_object(w);
+ *   return nebo_json_writer_finish(w, output, NULL);  // {"result":0.30000000000000004}
+ *
+ * For execute_buf and async handlers, nebo_tool_output_json() returns a
+ * writer that builds the document directly in the response.
+ */
+typedef struct nebo_json_writer nebo_json_writer_t;
+
+/** Create a writer. capacity: initial buffer size (0 = 256 bytes). */
+nebo_json_writer_t *nebo_json_writer_new(size_t capacity);
+
+void nebo_json_write_begin_object(nebo_json_writer_t *w);
+void nebo_json_write_end_object(nebo_json_writer_t *w);
+void nebo_json_write_begin_array(nebo_json_writer_t *w);
+void nebo_json_write_end_array(nebo_json_writer_t *w);
+
+/** Member key; the next value written belongs to it. */
+void nebo_json_write_key(nebo_json_writer_t *w, const char *key);
+void nebo_json_write_keyn(nebo_json_writer_t *w, const char *key, size_t len);
+
+/** String value. NULL writes null. Bytes are copied as-is apart from escapes. */
+void nebo_json_write_string(nebo_json_writer_t *w, const char *s);
+void nebo_json_write_stringn(nebo_json_writer_t *w, const char *s, size_t len);
+
+void nebo_json_write_number(nebo_json_writer_t *w, double v);
+void nebo_json_write_int(nebo_json_writer_t *w, long long v);
+void nebo_json_write_bool(nebo_json_writer_t *w, int v);
+void nebo_json_write_null(nebo_json_writer_t *w);
+
+/** Already-serialized JSON value, inserted verbatim (not validated). */
+void nebo_json_write_raw(nebo_json_writer_t *w, const char *json, size_t len);
+
+/** The bytes written so far (not NUL-terminated). len (optional) receives the count. */
+const char *nebo_json_writer_data(const nebo_json_writer_t *w, size_t *len);
+
+/**
+ * Finish the document and free the writer. Returns 0 on success, -1 if the
+ * document is incomplete or a write failed.
+ *
+ * On success, out (optional) receives the NUL-terminated buffer itself, no
+ * copy made, for the caller to free(); this matches execute's output
+ * contract. len (optional) receives its length. For a writer from
+ * nebo_tool_output_json() the document is already in the response and out
+ * is set to NULL; on failure whatever it wrote is removed again.
+ */
+int nebo_json_writer_finish(nebo_json_writer_t *w, char **out, size_t *len);
+
+/** Discard a writer without finishing it. Safe to call with NULL. */
+void nebo_json_writer_free(nebo_json_writer_t *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NEBO_JSON_H */
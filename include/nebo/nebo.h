@@ -9,6 +9,9 @@
 #include "schedule.h"
 #include "types.h"
 #include "schema.h"
+#include "input.h"
+#include "json.h"
+#include "call.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,10 +28,29 @@ extern "C" {
 
 typedef struct nebo_app nebo_app_t;
 
+/**
+ * gRPC server engine.
+ *
+ * NEBO_ENGINE_SYNC:     default. Each call, including long-lived streams
+ *                       (Receive, Stream, Triggers), holds a gRPC pool thread.
+ * NEBO_ENGINE_CALLBACK: unary handlers run on a fixed pool of worker threads;
+ *                       stream handlers run on their own threads and write
+ *                       asynchronously, so open streams never delay unary calls.
+ */
+typedef enum {
+    NEBO_ENGINE_SYNC = 0,
+    NEBO_ENGINE_CALLBACK = 1,
+} nebo_engine_t;
+
 /** Create a new Nebo app. Reads NEBO_APP_* env vars. */
 nebo_app_t *nebo_app_new(void);
 
-/** Register a tool capability handler. */
+/**
+ * Register a tool capability handler. May be called once per tool to serve
+ * several tools from one app; Execute dispatches on the request's tool name.
+ * The first tool registered is the default. Registering a name again
+ * replaces the earlier handler.
+ */
 void nebo_app_register_tool(nebo_app_t *app, const nebo_tool_handler_t *handler);
 
 /** Register a channel capability handler. */
@@ -40,6 +62,18 @@ void nebo_app_register_gateway(nebo_app_t *app, const nebo_gateway_handler_t *ha
 /** Register a UI capability handler. */
 void nebo_app_register_ui(nebo_app_t *app, const nebo_ui_handler_t *handler);
 
+/**
+ * Serve the files under dir, relative to nebo_app_dir(), at URL paths
+ * starting with url_prefix (e.g. "/static", or "/" for the whole site).
+ * GET and HEAD for those files are answered by the SDK before the UI
+ * handler is called: with a strong ETag, a 304 for a matching If-None-Match,
+ * and gzip for clients that accept it; a path ending in "/" serves its
+ * index.html. Files are loaded once in nebo_app_run(), so edits made while
+ * the app runs are not seen. Other requests, including unknown paths under
+ * the prefix, go to the UI handler, or get 404 without one.
+ */
+void nebo_app_serve_static(nebo_app_t *app, const char *url_prefix, const char *dir);
+
 /** Register a comm capability handler. */
 void nebo_app_register_comm(nebo_app_t *app, const nebo_comm_handler_t *handler);
 
@@ -49,6 +83,20 @@ void nebo_app_register_schedule(nebo_app_t *app, const nebo_schedule_handler_t *
 /** Set a callback for settings updates from Nebo. */
 void nebo_app_on_configure(nebo_app_t *app, void (*callback)(const nebo_string_map_t *settings));
 
+/**
+ * Select the server engine. Must be called before nebo_app_run().
+ * threads: worker threads for unary handlers (NEBO_ENGINE_CALLBACK only);
+ *          0 means one per CPU.
+ */
+void nebo_app_set_engine(nebo_app_t *app, nebo_engine_t engine, int threads);
+
+/**
+ * Size the worker pool that ExecuteBatch fans out on, which is also the
+ * most calls of one batch that run at once. 0 (default) means one per CPU.
+ * Must be called before nebo_app_run().
+ */
+void nebo_app_set_batch_parallelism(nebo_app_t *app, int threads);
+
 /**
  * Start the gRPC server and block until SIGTERM/SIGINT.
  * Returns 0 on clean shutdown, non-zero on error.
@@ -0,0 +1,110 @@
+#ifndef NEBO_ROUTER_H
+#define NEBO_ROUTER_H
+
+#include <stddef.h>
+
+#include "ui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Router dispatches UI requests by method and path pattern.
+ *
+ * Usage:
+ *   static nebo_router_t *router;
+ *
+ *   static int get_user(const nebo_http_request_t *req, const nebo_route_match_t *m,
+ *                       nebo_http_response_t *resp) {
+ *       size_t len;
+ *       const char *id = nebo_route_param(m, "id", &len);  // not NUL-terminated
+ *       ...
+ *   }
+ *
+ *   static int handle_request(const nebo_http_request_t *req, nebo_http_response_t *resp) {
+ *       return nebo_router_handle(router, req, resp);
+ *   }
+ *
+ *   router = nebo_router_new();
+ *   nebo_router_add(router, "GET", "/api/users/:id", get_user, NULL);
+ *   nebo_router_add(router, "POST", "/api/users", create_user, NULL);
+ *
+ * A pattern is a path whose segments may be ":name", matching one non-empty
+ * segment, or, as the last segment only, "*name", matching the rest of the
+ * path including slashes (possibly empty). Where patterns overlap, literal
+ * segments win over ":name", which wins over "*name", whatever the order
+ * they were added in.
+ *
+ * Patterns compile into a radix trie, so matching costs one walk down the
+ * path rather than a compare per route. Matching allocates nothing: params
+ * are slices of the request path. Add every route before serving; after
+ * that the router is read-only and safe to match from any thread.
+ */
+
+typedef struct nebo_router nebo_router_t;
+
+/** Most params one pattern may hold. */
+#define NEBO_ROUTE_MAX_PARAMS 8
+
+/** One matched param: value[0..len) is a slice of the request path. */
+typedef struct {
+    const char *name;
+    const char *value;
+    size_t len;
+} nebo_route_param_t;
+
+/** A matched route: its params and the user_data it was added with. */
+typedef struct {
+    nebo_route_param_t params[NEBO_ROUTE_MAX_PARAMS];
+    int param_count;
+    void *user_data;
+} nebo_route_match_t;
+
+/** Route handler. Same contract as nebo_ui_handler_t.handle_request. */
+typedef int (*nebo_route_fn)(const nebo_http_request_t *req, const nebo_route_match_t *match,
+                             nebo_http_response_t *resp);
+
+/** Create an empty router. */
+nebo_router_t *nebo_router_new(void);
+
+/**
+ * Add a route. method: "GET", "POST", ..., or NULL for any method; a GET
+ * route also serves HEAD unless a HEAD route is added. Returns 0, or -1 if
+ * the pattern is malformed, has too many params, names a param differently
+ * from an overlapping pattern at the same position, or repeats a method and
+ * pattern already added.
+ */
+int nebo_router_add(nebo_router_t *r, const char *method, const char *pattern,
+                    nebo_route_fn fn, void *user_data);
+
+/**
+ * Find the route for method and path (no query string). Returns the handler
+ * and fills match, or NULL with *status set to 404 (no pattern matches the
+ * path) or 405 (patterns match, but not for this method). status may be NULL.
+ */
+nebo_route_fn nebo_router_match(const nebo_router_t *r, const char *method, const char *path,
+                                nebo_route_match_t *match, int *status);
+
+/**
+ * Dispatch req to its route. Answers 404 or 405 itself (with an empty body)
+ * when no route matches. Returns what the route handler returned, or 0.
+ */
+int nebo_router_handle(const nebo_router_t *r, const nebo_http_request_t *req,
+                       nebo_http_response_t *resp);
+
+/**
+ * Look up a param of a match by name. Returns a pointer into the request
+ * path and sets *len (len may be NULL), or returns NULL if the route has no
+ * such param.
+ */
+const char *nebo_route_param(const nebo_route_match_t *match, const char *name, size_t *len);
+
+/** Free a router and its routes. */
+void nebo_router_free(nebo_router_t *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NEBO_ROUTER_H */
@@ -1,10 +1,23 @@
 #ifndef NEBO_TOOL_H
 #define NEBO_TOOL_H
 
+#include <stddef.h>
+
+#include "types.h"
+#include "input.h"
+#include "json.h"
+#include "call.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Completion handle for one execute_async() call. Opaque. */
+typedef struct nebo_tool_completion nebo_tool_completion_t;
+
+/** Output sink writing straight into the ExecuteResponse. Opaque, SDK-owned. */
+typedef struct nebo_tool_output nebo_tool_output_t;
+
 /**
  * Tool handler — implement this to provide a tool capability.
  *
@@ -14,6 +27,55 @@ extern "C" {
  *
  * requires_approval: optional, NULL means false.
  *          Return 1 if this tool needs user confirmation, 0 otherwise.
+ *
+ * execute_async: optional non-blocking alternative to execute, used instead
+ *          of it when set. Receives the NUL-terminated input and its length
+ *          (valid until completion) and must return promptly. Finish later,
+ *          from any thread, with exactly one call to nebo_tool_complete() or
+ *          nebo_tool_fail(). Return 0 once started; non-zero is a fatal error
+ *          and done must then not be used.
+ *          With NEBO_ENGINE_CALLBACK, in-flight executions hold no thread.
+ *
+ * execute_buf: optional zero-copy alternative to execute, used instead of it
+ *          when set. input points at the request bytes (len bytes, also
+ *          NUL-terminated) without copying. Write the result into out with
+ *          the nebo_tool_output_* functions; the bytes land directly in the
+ *          response. Return 0 on success, non-zero on fatal error.
+ *
+ * cache:   optional, 0 = off. Set to 1 if the result depends only on the
+ *          input (a pure function, like a calculator). The SDK then memoizes
+ *          successful, non-error results keyed by the input with
+ *          whitespace, key order, string escapes and number spelling
+ *          ignored, and collapses concurrent identical calls into one
+ *          execution. Collapsed calls share only a successful
+ *          result; if that execution fails or its call is cancelled, the
+ *          next waiting call runs the tool itself. cache_max_bytes bounds
+ *          the LRU (0 = 16 MiB); cache_ttl_ms expires entries (0 = never).
+ *
+ * max_in_flight: optional, 0 = unlimited. Caps concurrent executions of this
+ *          tool. Up to max_queued further calls wait in FIFO order for a
+ *          slot; beyond that Execute fails fast with RESOURCE_EXHAUSTED.
+ *          The time a call spent queued is returned in queue_wait_us (on
+ *          the first chunk for ExecuteStream). A queued call whose host
+ *          hangs up or whose deadline passes leaves the queue without
+ *          running. Cache hits never take a slot.
+ *
+ * execute_stream: optional. Serves the ExecuteStream RPC: call push() for
+ *          each chunk as it is produced, so the host sees output before the
+ *          tool finishes and the tool never holds the whole result. push()
+ *          blocks while the host is behind and returns non-zero once the
+ *          stream is cancelled; stop then. Return 0 when done, non-zero on
+ *          fatal error. Counts against max_in_flight; never cached.
+ *          Tools without it answer ExecuteStream from their regular handler.
+ *
+ * validator: optional, from nebo_schema_compile(). Every input is validated
+ *          before any handler runs; invalid input is answered with an
+ *          is_error result naming the problem and never reaches the tool.
+ *
+ * execute_input: optional, requires validator. Receives the validated,
+ *          typed view (valid until return) instead of raw JSON, so the
+ *          handler reads fields with nebo_input_get_number() and friends.
+ *          Same output contract as execute. Used in place of execute.
  */
 typedef struct {
     const char *name;
@@ -21,8 +83,100 @@ typedef struct {
     const char *schema; /* JSON Schema string */
     int (*execute)(const char *input_json, char **output, int *is_error);
     int (*requires_approval)(void); /* optional, NULL = false */
+    int (*execute_async)(const char *input_json, size_t len,
+                         nebo_tool_completion_t *done); /* optional */
+    int (*execute_buf)(const char *input_json, size_t len,
+                       nebo_tool_output_t *out); /* optional */
+    int cache;                /* optional, 1 = memoize results */
+    size_t cache_max_bytes;   /* optional, 0 = 16 MiB */
+    int cache_ttl_ms;         /* optional, 0 = no expiry */
+    int max_in_flight;        /* optional, 0 = unlimited */
+    int max_queued;           /* optional, 0 = reject when all slots are busy */
+    int (*execute_stream)(const char *input_json, size_t len,
+                          nebo_push_tool_chunk_fn push,
+                          void *stream_ctx); /* optional */
+    const nebo_validator_t *validator; /* optional */
+    int (*execute_input)(const nebo_input_t *in, char **output,
+                         int *is_error); /* optional */
 } nebo_tool_handler_t;
 
+/**
+ * Result cache counters for a tool registered with cache = 1.
+ */
+typedef struct {
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long collapsed;  /* calls that waited on an identical in-flight call */
+    unsigned long long evictions;  /* entries dropped for size or TTL */
+    size_t entries;
+    size_t bytes;
+} nebo_tool_cache_stats_t;
+
+/**
+ * Read the result cache counters of a served tool. Safe from any thread
+ * while the app runs. Returns 0 on success, -1 if the tool has no cache.
+ */
+int nebo_tool_cache_stats(const nebo_tool_handler_t *tool, nebo_tool_cache_stats_t *out);
+
+/**
+ * Admission counters for a tool registered with max_in_flight > 0.
+ */
+typedef struct {
+    int in_flight;
+    int queued;
+    unsigned long long admitted;
+    unsigned long long rejected;       /* RESOURCE_EXHAUSTED replies */
+    unsigned long long wait_us_total;  /* summed queue wait of admitted calls */
+    unsigned long long wait_us_max;
+    unsigned long long abandoned;      /* left the queue cancelled or past their deadline */
+} nebo_tool_admission_stats_t;
+
+/**
+ * Read the admission counters of a served tool. Safe from any thread while
+ * the app runs. Returns 0 on success, -1 if the tool has no limit.
+ */
+int nebo_tool_admission_stats(const nebo_tool_handler_t *tool, nebo_tool_admission_stats_t *out);
+
+/** Pre-size the output buffer. A hint only; writes grow it as needed. */
+void nebo_tool_output_reserve(nebo_tool_output_t *out, size_t capacity);
+
+/** Append len bytes to the output. */
+void nebo_tool_output_write(nebo_tool_output_t *out, const void *data, size_t len);
+
+/**
+ * Grow the output by len bytes and return a pointer to them for the caller
+ * to fill in place. Valid until the next call on out.
+ */
+char *nebo_tool_output_extend(nebo_tool_output_t *out, size_t len);
+
+/**
+ * JSON writer appending straight into the output, so the result is built
+ * in place with no copy. Finish it with nebo_json_writer_finish() before
+ * returning from the handler (or completing the async call).
+ */
+nebo_json_writer_t *nebo_tool_output_json(nebo_tool_output_t *out);
+
+/** Mark the output as an error message (default: not an error). */
+void nebo_tool_output_set_error(nebo_tool_output_t *out, int is_error);
+
+/**
+ * Output sink of an async execution, for writing the result in place.
+ * Finish with nebo_tool_complete(done, NULL, is_error) to keep what was written.
+ */
+nebo_tool_output_t *nebo_tool_completion_output(nebo_tool_completion_t *done);
+
+/**
+ * The RPC an async execution serves, for checking cancellation or the
+ * deadline after execute_async() has returned. Valid until completion.
+ */
+nebo_call_t *nebo_tool_completion_call(nebo_tool_completion_t *done);
+
+/** Finish an async execution with a result. output is copied; may be NULL. */
+void nebo_tool_complete(nebo_tool_completion_t *done, const char *output, int is_error);
+
+/** Finish an async execution with a fatal error (the RPC fails with INTERNAL). */
+void nebo_tool_fail(nebo_tool_completion_t *done, const char *message);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,6 +1,8 @@
 #ifndef NEBO_TYPES_H
 #define NEBO_TYPES_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -222,6 +224,15 @@ typedef struct {
     const nebo_string_map_t *metadata;
 } nebo_update_schedule_request_t;
 
+/**
+ * One piece of streamed tool output. data need not be NUL-terminated.
+ */
+typedef struct {
+    const char *data;
+    size_t len;
+    int is_error;  /* 1 marks the whole result as an error */
+} nebo_tool_chunk_t;
+
 /**
  * Push callback typedefs for server-streaming RPCs.
  * The gRPC bridge passes a push function and opaque context to the handler.
@@ -232,6 +243,7 @@ typedef int (*nebo_push_gateway_event_fn)(const nebo_gateway_event_t *event, voi
 typedef int (*nebo_push_inbound_message_fn)(const nebo_inbound_message_t *msg, void *stream_ctx);
 typedef int (*nebo_push_comm_message_fn)(const nebo_comm_message_t *msg, void *stream_ctx);
 typedef int (*nebo_push_schedule_trigger_fn)(const nebo_schedule_trigger_t *trigger, void *stream_ctx);
+typedef int (*nebo_push_tool_chunk_fn)(const nebo_tool_chunk_t *chunk, void *stream_ctx);
 
 #ifdef __cplusplus
 }
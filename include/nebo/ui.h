@@ -77,13 +77,93 @@ typedef struct {
     int body_len;
 } nebo_http_response_t;
 
+/**
+ * A streamed HTTP exchange (see handle_stream). Bodies move in chunks
+ * instead of one buffer: uploads are read as they arrive and responses are
+ * sent as they are produced, so neither side holds a whole body and the
+ * browser gets the first bytes as soon as the handler writes them.
+ * Only the handler's thread may use the stream, and only until it returns.
+ */
+typedef struct nebo_http_stream nebo_http_stream_t;
+
+/**
+ * Read up to cap bytes of the request body. Returns the number read, 0 at
+ * the end of the body, or -1 if the host cancelled the request.
+ */
+long nebo_http_stream_read(nebo_http_stream_t *s, void *buf, size_t cap);
+
+/**
+ * Send the status and headers (headers may be NULL). Must come before the
+ * body; the first write sends 200 with no headers if it was not called.
+ * Returns 0, or -1 if the head was already sent or the host went away.
+ */
+int nebo_http_stream_write_head(nebo_http_stream_t *s, int status_code,
+                                const nebo_string_map_t *headers);
+
+/** Send len bytes of the response body. Returns 0, or -1 if the host went away. */
+int nebo_http_stream_write(nebo_http_stream_t *s, const void *data, size_t len);
+
+/**
+ * Send one server-sent event: an optional event name and data, split into
+ * one "data:" line per line of data. Without an earlier head, sends 200 with
+ * Content-Type: text/event-stream first. Returns 0, or -1 if the host went
+ * away; a live panel writes events until then.
+ */
+int nebo_http_stream_write_event(nebo_http_stream_t *s, const char *event, const char *data);
+
 /**
  * UI handler — implement this to serve HTTP-based UI panels.
+ *
+ * handle_request gets the whole request body and returns the whole
+ * response. handle_stream (optional) serves the same requests through a
+ * nebo_http_stream_t instead; req->body is NULL and the body is read from
+ * the stream. When only one is set it serves both RPCs: a streamed request
+ * to an app without handle_stream is buffered for handle_request, and a
+ * buffered request to an app without handle_request runs handle_stream with
+ * the body in memory. Return 0 on success; non-zero fails the request
+ * (after the head was sent, the host sees the response cut short).
+ *
+ * cache:   optional, 0 = off. Set to 1 to cache GET responses from
+ *          handle_request that carry Cache-Control: max-age (or s-maxage)
+ *          and neither no-store, no-cache, private nor Set-Cookie. Entries
+ *          are keyed by path, query and the request headers named in
+ *          cache_vary, and answer GET and HEAD until they expire.
+ *          Concurrent identical GET misses run the handler once; the others
+ *          wait and share a cacheable result. cache_max_bytes bounds the
+ *          LRU (0 = 16 MiB). A response whose Vary names a header missing
+ *          from cache_vary is not cached. The cache is shared by every
+ *          session: a GET carrying Authorization or Cookie is stored, and
+ *          answered from the cache, only when the response also says
+ *          public or s-maxage, so per-user max-age responses stay per-user.
+ *          A request waiting on an identical miss gives up when its call is
+ *          cancelled or its deadline passes.
  */
 typedef struct {
     int (*handle_request)(const nebo_http_request_t *req, nebo_http_response_t *resp);
+    int (*handle_stream)(const nebo_http_request_t *req, nebo_http_stream_t *stream);
+    int cache;                      /* optional, 1 = cache GET responses */
+    size_t cache_max_bytes;         /* optional, 0 = 16 MiB */
+    const char *const *cache_vary;  /* optional, NULL-terminated header names */
 } nebo_ui_handler_t;
 
+/**
+ * Response cache counters for a UI handler registered with cache = 1.
+ */
+typedef struct {
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long collapsed;  /* requests that waited on an identical in-flight request */
+    unsigned long long evictions;  /* entries dropped for size or expiry */
+    size_t entries;
+    size_t bytes;
+} nebo_http_cache_stats_t;
+
+/**
+ * Read the response cache counters of a served UI handler. Safe from any
+ * thread while the app runs. Returns 0 on success, -1 if it has no cache.
+ */
+int nebo_ui_cache_stats(const nebo_ui_handler_t *ui, nebo_http_cache_stats_t *out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,6 +1,7 @@
 #ifndef NEBO_VIEW_H
 #define NEBO_VIEW_H
 
+#include "json.h"
 #include "ui.h"
 
 #ifdef __cplusplus
@@ -18,6 +19,11 @@ extern "C" {
  *   nebo_ui_view_t *view = nebo_view_build(vb);
  *   // ... use view ...
  *   nebo_view_free_view(view);
+ *
+ * A builder holds any number of blocks. Every string it copies lives in one
+ * arena that the built view takes over, so nebo_view_free_view() is a single
+ * release however large the view; block types and the well-known variants
+ * are static strings and are never copied.
  */
 
 typedef struct nebo_view_builder nebo_view_builder_t;
@@ -57,15 +63,160 @@ nebo_view_builder_t *nebo_view_divider(nebo_view_builder_t *vb, const char *bloc
 nebo_view_builder_t *nebo_view_image(nebo_view_builder_t *vb, const char *block_id,
                                       const char *src, const char *alt);
 
-/** Build the view. Returns a heap-allocated nebo_ui_view_t. Free with nebo_view_free_view(). */
+/**
+ * Build the view and reset the builder's blocks (its id and title are kept).
+ * The view owns all of its strings; release it with nebo_view_free_view()
+ * only, never field by field. Returns NULL if the builder ran out of memory.
+ */
 nebo_ui_view_t *nebo_view_build(nebo_view_builder_t *vb);
 
 /** Free the builder (does not free the built view). */
 void nebo_view_free(nebo_view_builder_t *vb);
 
-/** Free a view returned by nebo_view_build(). */
+/* ── Shared views ────────────────────────────────────────────────────── */
+
+/**
+ * Views from nebo_view_build() and nebo_view_derive() are immutable and
+ * reference counted, so one view can be handed to any number of sessions and
+ * threads: each holder takes a reference with nebo_view_retain() and drops
+ * it with nebo_view_free_view(). Never write through a built view's fields.
+ *
+ * Per-session variants are derived rather than rebuilt. A derived view
+ * shares every string and option list of its base and copies only the block
+ * that changed (plus the flat block array), keeping the base alive until it
+ * is released itself:
+ *
+ *   nebo_ui_block_t b = *nebo_view_find(shared, "alerts");
+ *   b.value = "true";
+ *   nebo_ui_view_t *mine = nebo_view_derive(shared, "alerts", &b);
+ *
+ * These calls accept only views the SDK built.
+ */
+
+/** Take another reference to view; returns view. */
+nebo_ui_view_t *nebo_view_retain(nebo_ui_view_t *view);
+
+/** Drop a reference; the last one frees the view. Safe to call with NULL. */
 void nebo_view_free_view(nebo_ui_view_t *view);
 
+/** The first block with block_id, or NULL. */
+const nebo_ui_block_t *nebo_view_find(const nebo_ui_view_t *view, const char *block_id);
+
+/**
+ * A new view equal to base except that the first block with block_id is
+ * replaced by a copy of *block, or removed when block is NULL. base is not
+ * modified. Returns NULL if no block has block_id or on OOM.
+ */
+nebo_ui_view_t *nebo_view_derive(nebo_ui_view_t *base, const char *block_id,
+                                 const nebo_ui_block_t *block);
+
+/* ── Diffing ─────────────────────────────────────────────────────────── */
+
+/**
+ * A patch turns one view into the next, so an event handler can ship what
+ * changed instead of the whole view. Blocks are matched by block_id.
+ * Applying the ops in order to the old block list gives the new one:
+ *
+ *   REMOVE  drop the block at index (old positions, descending)
+ *   INSERT  insert block at index (new positions, ascending)
+ *   UPDATE  replace the block at index (new position) by block
+ *
+ * A block that moved is removed and reinserted; blocks that kept their
+ * relative order stay put. Blocks without an id, and the second and later
+ * blocks sharing an id, cannot be matched and are always reinserted.
+ */
+
+typedef enum {
+    NEBO_VIEW_OP_REMOVE,
+    NEBO_VIEW_OP_INSERT,
+    NEBO_VIEW_OP_UPDATE
+} nebo_view_op_kind_t;
+
+typedef struct {
+    nebo_view_op_kind_t kind;
+    const char *block_id;
+    int index;                    /* see above; REMOVE counts in the old view */
+    const nebo_ui_block_t *block; /* INSERT, UPDATE: the new block; REMOVE: NULL */
+} nebo_view_op_t;
+
+typedef struct {
+    const char *view_id;     /* the new view's id */
+    const char *title;       /* the new title if it changed, else NULL */
+    const nebo_view_op_t *ops;
+    int op_count;            /* 0 with title NULL: nothing to send */
+} nebo_view_patch_t;
+
+/**
+ * Diff two views. old_view = NULL diffs against an empty view (every block
+ * is an insert: a full render). The patch borrows strings and blocks from
+ * new_view and is valid while new_view is. Returns NULL on OOM.
+ */
+nebo_view_patch_t *nebo_view_diff(const nebo_ui_view_t *old_view,
+                                  const nebo_ui_view_t *new_view);
+
+/**
+ * Write the patch as one JSON object:
+ *   {"view_id":"main","title":"...","ops":[
+ *     {"op":"remove","index":4,"block_id":"b1"},
+ *     {"op":"insert","index":0,"block":{"block_id":"b2","type":"text",...}},
+ *     {"op":"update","index":2,"block":{"block_id":"b3","type":"toggle","value":"true"}}]}
+ * "title" appears only when it changed; block fields that are unset are left out.
+ */
+void nebo_view_patch_write_json(const nebo_view_patch_t *patch, nebo_json_writer_t *w);
+
+/** Free a patch returned by nebo_view_diff(). Safe to call with NULL. */
+void nebo_view_patch_free(nebo_view_patch_t *patch);
+
+/* ── Rendering ───────────────────────────────────────────────────────── */
+
+/**
+ * Renders views to JSON or HTML for a UI app's handle_request, caching the
+ * encoded bytes of every block by the block's content. Re-rendering a view
+ * where most blocks are unchanged re-encodes only the ones that changed;
+ * a block with the same content in another view or session is a hit too.
+ * A renderer is safe to share between threads. Every render call takes
+ * r = NULL to render without a cache.
+ *
+ * JSON: {"view_id":"main","title":"...","blocks":[{...}]} with blocks as in
+ * nebo_view_patch_write_json(). HTML: a <div class="nebo-view"> holding one
+ * <div class="nebo-block nebo-TYPE" data-block-id="..."> per block, with
+ * form controls named by block_id and all text and attributes escaped.
+ */
+
+typedef struct nebo_view_renderer nebo_view_renderer_t;
+
+/** Create a renderer whose cache holds at most max_bytes (0 = 4 MiB). */
+nebo_view_renderer_t *nebo_view_renderer_new(size_t max_bytes);
+
+/**
+ * Write view as one JSON value into w. Running out of memory fails the
+ * writer, as any write does; nebo_json_writer_finish() reports it.
+ */
+void nebo_view_render_json(nebo_view_renderer_t *r, const nebo_ui_view_t *view,
+                           nebo_json_writer_t *w);
+
+/**
+ * Render view as HTML into a malloc'd, NUL-terminated buffer (free() it).
+ * len (optional) receives its length. Returns 0, or -1 on OOM.
+ */
+int nebo_view_render_html(nebo_view_renderer_t *r, const nebo_ui_view_t *view,
+                          char **out, size_t *len);
+
+/** Block cache counters. */
+typedef struct {
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;  /* entries dropped to stay under max_bytes */
+    size_t entries;
+    size_t bytes;
+} nebo_view_render_stats_t;
+
+/** Read a renderer's counters. Safe from any thread. */
+void nebo_view_renderer_stats(nebo_view_renderer_t *r, nebo_view_render_stats_t *out);
+
+/** Free a renderer. Safe to call with NULL. */
+void nebo_view_renderer_free(nebo_view_renderer_t *r);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,60 @@
+/**
+ * Nebo C SDK — bump allocator for per-call scratch memory.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+#define ARENA_ALIGN 16
+#define ARENA_DEFAULT_BLOCK 4096
+
+struct nebo_arena_block {
+    nebo_arena_block_t *next;
+    size_t cap;
+    size_t used;
+    _Alignas(ARENA_ALIGN) unsigned char data[];
+};
+
+void nebo_arena_init(nebo_arena_t *a, size_t first_block) {
+    a->head = NULL;
+    a->next_size = first_block ? first_block : ARENA_DEFAULT_BLOCK;
+}
+
+void *nebo_arena_alloc(nebo_arena_t *a, size_t n) {
+    size_t need = (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    nebo_arena_block_t *b = a->head;
+    if (!b || b->cap - b->used < need) {
+        size_t cap = a->next_size;
+        while (cap < need) cap *= 2;
+        b = malloc(sizeof(nebo_arena_block_t) + cap);
+        if (!b) return NULL;
+        b->next = a->head;
+        b->cap = cap;
+        b->used = 0;
+        a->head = b;
+        a->next_size = cap * 2;
+    }
+    void *p = b->data + b->used;
+    b->used += need;
+    return p;
+}
+
+char *nebo_arena_strndup(nebo_arena_t *a, const char *s, size_t len) {
+    char *p = nebo_arena_alloc(a, len + 1);
+    if (!p) return NULL;
+    memcpy(p, s, len);
+    p[len] = '\0';
+    return p;
+}
+
+void nebo_arena_free(nebo_arena_t *a) {
+    nebo_arena_block_t *b = a->head;
+    while (b) {
+        nebo_arena_block_t *next = b->next;
+        free(b);
+        b = next;
+    }
+    a->head = NULL;
+}
@@ -0,0 +1,38 @@
+#ifndef NEBO_ARENA_H
+#define NEBO_ARENA_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bump allocator. Allocations are never freed individually; the whole arena
+ * is released at once. Blocks grow geometrically, so a short-lived arena
+ * sized from its input usually makes a single malloc().
+ */
+typedef struct nebo_arena_block nebo_arena_block_t;
+
+typedef struct {
+    nebo_arena_block_t *head; /* current block; older blocks chain behind it */
+    size_t next_size;
+} nebo_arena_t;
+
+/** Prepare an empty arena. first_block: size of the first block (0 = 4 KiB). */
+void nebo_arena_init(nebo_arena_t *a, size_t first_block);
+
+/** Allocate n bytes aligned for any scalar. Returns NULL on OOM. */
+void *nebo_arena_alloc(nebo_arena_t *a, size_t n);
+
+/** Copy len bytes into the arena and NUL-terminate them. */
+char *nebo_arena_strndup(nebo_arena_t *a, const char *s, size_t len);
+
+/** Release every block. The arena may be reused after nebo_arena_init(). */
+void nebo_arena_free(nebo_arena_t *a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NEBO_ARENA_H */
@@ -0,0 +1,163 @@
+/**
+ * Nebo C SDK — per-call deadline and cancellation for handlers.
+ */
+
+#include "call_context.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+static thread_local nebo_call *tls_current = nullptr;
+
+/**
+ * Polls the calls that have a cancel callback and fires it once a call is
+ * cancelled. gRPC offers no cancel notification that works for both the
+ * sync and the callback engine, so one thread checks every few
+ * milliseconds; it sleeps while no callback is registered. Each callback
+ * runs on a thread of its own, so a slow one delays neither the polling
+ * nor the callbacks of other calls.
+ */
+class CancelWatcher {
+public:
+    static constexpr auto kInterval = std::chrono::milliseconds(5);
+
+    static CancelWatcher &Get() {
+        static CancelWatcher *w = new CancelWatcher; /* never destroyed; the thread outlives main */
+        return *w;
+    }
+
+    void Set(nebo_call *call, nebo_call_cancel_fn fn, void *user_data) {
+        std::lock_guard<std::mutex> lk(mu_);
+        call->registered.store(true, std::memory_order_relaxed);
+        call->fn = fn;
+        call->user_data = user_data;
+        if (fn && !call->watched && !call->firing) {
+            call->watched = true;
+            calls_.push_back(call);
+            cv_.notify_one();
+        } else if (!fn && call->watched) {
+            Remove(call);
+        }
+    }
+
+    /** Checks the calls now rather than at the next poll. */
+    void Wake() {
+        std::lock_guard<std::mutex> lk(mu_);
+        cv_.notify_one();
+    }
+
+    void Detach(nebo_call *call) {
+        std::unique_lock<std::mutex> lk(mu_);
+        if (call->watched) Remove(call);
+        call->fn = nullptr;
+        auto self = firing_.find(std::this_thread::get_id());
+        if (self != firing_.end() && self->second == call) {
+            /* Finished from inside its own callback: don't wait for ourselves,
+               and tell Fire() not to touch the call afterwards. */
+            firing_.erase(self);
+            call->firing = false;
+            return;
+        }
+        fired_.wait(lk, [call] { return !call->firing; });
+    }
+
+private:
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::condition_variable fired_;
+    std::vector<nebo_call *> calls_;
+    std::unordered_map<std::thread::id, nebo_call *> firing_; /* by the thread running its callback */
+
+    CancelWatcher() { std::thread([this] { Loop(); }).detach(); }
+
+    void Remove(nebo_call *call) {
+        call->watched = false;
+        calls_.erase(std::find(calls_.begin(), calls_.end(), call));
+    }
+
+    void Fire(nebo_call_cancel_fn fn, void *user_data) {
+        { std::lock_guard<std::mutex> lk(mu_); } /* until Loop() has recorded us in firing_ */
+        fn(user_data);
+        std::lock_guard<std::mutex> lk(mu_);
+        auto self = firing_.find(std::this_thread::get_id());
+        if (self != firing_.end()) {
+            self->second->firing = false;
+            firing_.erase(self);
+        }
+        fired_.notify_all();
+    }
+
+    void Loop() {
+        std::unique_lock<std::mutex> lk(mu_);
+        for (;;) {
+            cv_.wait(lk, [this] { return !calls_.empty(); });
+            for (size_t i = 0; i < calls_.size();) {
+                nebo_call *call = calls_[i];
+                if (!call->Cancelled()) {
+                    i++;
+                    continue;
+                }
+                Remove(call);
+                call->firing = true;
+                std::thread t(&CancelWatcher::Fire, this, call->fn, call->user_data);
+                firing_[t.get_id()] = call;
+                t.detach();
+            }
+            cv_.wait_for(lk, kInterval);
+        }
+    }
+};
+
+void nebo_call::Detach() {
+    if (registered.load(std::memory_order_relaxed)) CancelWatcher::Get().Detach(this);
+}
+
+long long nebo_call::DeadlineMs() const {
+    if (!ctx) return -1;
+    gpr_timespec raw = ctx->raw_deadline();
+    if (gpr_time_cmp(raw, gpr_inf_future(raw.clock_type)) == 0) return -1;
+    auto left = ctx->deadline() - std::chrono::system_clock::now();
+    long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(left).count();
+    return ms > 0 ? ms : 0;
+}
+
+bool nebo_call::Cancelled() const {
+    if (cancel_requested.load(std::memory_order_acquire)) return true;
+    if (!ctx) return false;
+    if (ctx->IsCancelled()) return true;
+    gpr_timespec raw = ctx->raw_deadline();
+    return gpr_time_cmp(raw, gpr_inf_future(raw.clock_type)) != 0 &&
+           ctx->deadline() <= std::chrono::system_clock::now();
+}
+
+void nebo_call::Cancel() {
+    cancel_requested.store(true, std::memory_order_release);
+    if (ctx) ctx->TryCancel();
+    if (registered.load(std::memory_order_relaxed)) CancelWatcher::Get().Wake();
+}
+
+CallScope::CallScope(nebo_call *call) : prev_(tls_current) { tls_current = call; }
+CallScope::~CallScope() { tls_current = prev_; }
+
+/* ── C API ───────────────────────────────────────────────────────────── */
+
+extern "C" nebo_call_t *nebo_call_current(void) { return tls_current; }
+
+extern "C" long long nebo_call_deadline_ms(const nebo_call_t *call) {
+    return call ? call->DeadlineMs() : -1;
+}
+
+extern "C" int nebo_call_is_cancelled(const nebo_call_t *call) {
+    return call && call->Cancelled() ? 1 : 0;
+}
+
+extern "C" int nebo_call_on_cancel(nebo_call_t *call, nebo_call_cancel_fn fn, void *user_data) {
+    if (!call) return -1;
+    CancelWatcher::Get().Set(call, fn, user_data);
+    return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * Nebo C SDK — per-call deadline and cancellation for handlers.
+ *
+ * Internal to the C++ shim. The services open a ScopedCall around every
+ * bridge method, so nebo_call_current() works in any handler without
+ * changing handler signatures.
+ */
+
+#ifndef NEBO_CALL_CONTEXT_H
+#define NEBO_CALL_CONTEXT_H
+
+#include <atomic>
+
+#include <grpcpp/grpcpp.h>
+
+extern "C" {
+#include "nebo/call.h"
+}
+
+/**
+ * One RPC as seen by its handler. The fields under "watch state" belong to
+ * the cancel watcher and are only touched under its lock. ctx is null for
+ * a handler that outlives its RPC (a polled gateway stream): such a call
+ * has no deadline and is cancelled only through Cancel().
+ */
+struct nebo_call {
+    explicit nebo_call(grpc::ServerContextBase *ctx) : ctx(ctx) {}
+    ~nebo_call() { Detach(); }
+    nebo_call(const nebo_call &) = delete;
+    nebo_call &operator=(const nebo_call &) = delete;
+
+    /** Stops cancel notification; waits out a callback already running. */
+    void Detach();
+
+    long long DeadlineMs() const;
+    bool Cancelled() const;
+
+    /**
+     * Cancels the RPC on the SDK's behalf (e.g. GatewayService.Cancel):
+     * Cancelled() turns true at once, and a registered cancel callback runs
+     * at once rather than at the watcher's next poll.
+     */
+    void Cancel();
+
+    grpc::ServerContextBase *ctx;
+    std::atomic<bool> registered{false}; /* nebo_call_on_cancel() was used */
+    std::atomic<bool> cancel_requested{false};
+
+    /* watch state */
+    nebo_call_cancel_fn fn = nullptr;
+    void *user_data = nullptr;
+    bool watched = false;
+    bool firing = false;
+};
+
+/** Makes call the thread's current call until the scope ends. */
+class CallScope {
+    nebo_call *prev_;
+public:
+    explicit CallScope(nebo_call *call);
+    ~CallScope();
+    CallScope(const CallScope &) = delete;
+    CallScope &operator=(const CallScope &) = delete;
+};
+
+/** A call for ctx, current on this thread for the object's lifetime. */
+class ScopedCall {
+    nebo_call call_;
+    CallScope scope_;
+public:
+    explicit ScopedCall(grpc::ServerContextBase *ctx) : call_(ctx), scope_(&call_) {}
+};
+
+#endif /* NEBO_CALL_CONTEXT_H */
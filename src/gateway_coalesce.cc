@@ -0,0 +1,180 @@
+/**
+ * Nebo C SDK — token coalescing for gateway streams.
+ *
+ * Each Stream has its own mutex, held by whichever of the handler thread
+ * or the timer thread is sending its batch, so batches go out in order.
+ * The timer keeps one deadline per batch and ignores deadlines of batches
+ * that were already written because they filled up or were cut short. It
+ * only try-locks a stream and offers its batch to the writer queue; when
+ * either is busy it looks again a window later, and the handler thread
+ * flushes a batch that is overdue on its next push().
+ */
+
+#include "gateway_coalesce.h"
+
+#include <cstring>
+
+#include "gateway_poll.h"
+
+namespace apb = apps::v0;
+
+struct GatewayCoalescer::Stream : std::enable_shared_from_this<GatewayCoalescer::Stream> {
+    GatewayCoalescer *owner;
+    Write write;
+    Offer offer;
+    Cancelled cancelled;
+    std::mutex mu;
+    apb::GatewayEvent pending;
+    bool has_pending = false;
+    uint64_t batch = 0;     /* bumped for each batch started */
+    Clock::time_point started{};  /* when the pending batch was started */
+    bool failed = false;    /* a write failed; every later push() fails */
+    bool closed = false;
+    Clock::time_point last_write{};
+
+    Stream(GatewayCoalescer *o, Write w, Offer f, Cancelled c)
+        : owner(o), write(std::move(w)), offer(std::move(f)), cancelled(std::move(c)) {}
+
+    /* Call with mu held. */
+    void Send(const apb::GatewayEvent &ge) {
+        if (!failed && !write(ge)) failed = true;
+        last_write = Clock::now();
+    }
+
+    /* Writes the pending batch, if any. Call with mu held. */
+    void Flush() {
+        if (!has_pending) return;
+        has_pending = false;
+        Send(pending);
+        pending.Clear();
+    }
+
+    /* Hands the pending batch to the writer queue without waiting; false if
+     * the queue is full and the batch is still pending. Call with mu held. */
+    bool Hand() {
+        int r = failed ? -1 : offer(pending);
+        if (r == 0) return false;
+        if (r < 0) failed = true;
+        has_pending = false;
+        pending.Clear();
+        last_write = Clock::now();
+        return true;
+    }
+};
+
+static bool coalescible(const char *type) {
+    return type && (strcmp(type, "text") == 0 || strcmp(type, "thinking") == 0);
+}
+
+static bool same(const std::string &field, const char *value) {
+    return field == (value ? value : "");
+}
+
+GatewayCoalescer::GatewayCoalescer(size_t max_bytes, std::chrono::milliseconds window)
+    : max_bytes_(max_bytes), window_(window) {
+    timer_ = std::thread([this] { Run(); });
+}
+
+GatewayCoalescer::~GatewayCoalescer() {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        stop_ = true;
+        cv_.notify_all();
+    }
+    timer_.join();
+}
+
+std::shared_ptr<GatewayCoalescer::Stream> GatewayCoalescer::Open(Write write, Offer offer,
+                                                                 Cancelled cancelled) {
+    return std::make_shared<Stream>(this, std::move(write), std::move(offer),
+                                    std::move(cancelled));
+}
+
+int GatewayCoalescer::Push(const nebo_gateway_event_t *evt, void *opaque) {
+    auto *s = static_cast<Stream *>(opaque);
+    GatewayCoalescer *c = s->owner;
+    std::unique_lock<std::mutex> lk(s->mu);
+    if (s->failed || s->closed) return -1;
+    if (s->cancelled()) {
+        s->failed = true;
+        s->has_pending = false;
+        return -1;
+    }
+
+    bool merge = coalescible(evt->type);
+    if (s->has_pending && merge && same(s->pending.type(), evt->type) &&
+        same(s->pending.model(), evt->model) && same(s->pending.request_id(), evt->request_id)) {
+        if (evt->content) s->pending.mutable_content()->append(evt->content);
+        if (s->pending.content().size() >= c->max_bytes_ || Clock::now() - s->started >= c->window_)
+            s->Flush();
+        return s->failed ? -1 : 0;
+    }
+
+    s->Flush();
+    if (s->failed) return -1;
+
+    /* A token after a quiet spell (the first one above all) goes out at once;
+     * only tokens that follow a recent write wait to be merged. */
+    Clock::time_point now = Clock::now();
+    if (!merge || now - s->last_write >= c->window_) {
+        apb::GatewayEvent ge;
+        nebo_gateway_event_to_proto(evt, &ge);
+        s->Send(ge);
+        return s->failed ? -1 : 0;
+    }
+
+    nebo_gateway_event_to_proto(evt, &s->pending);
+    s->has_pending = true;
+    s->started = now;
+    if (s->pending.content().size() >= c->max_bytes_) {
+        s->Flush();
+        return s->failed ? -1 : 0;
+    }
+    c->Schedule(now + c->window_, s->shared_from_this(), ++s->batch);
+    return 0;
+}
+
+bool GatewayCoalescer::Close(Stream *s) {
+    std::lock_guard<std::mutex> lk(s->mu);
+    s->Flush();
+    s->closed = true;
+    s->write = nullptr;
+    s->offer = nullptr;
+    s->cancelled = nullptr;
+    return !s->failed;
+}
+
+void GatewayCoalescer::Schedule(Clock::time_point at, const std::shared_ptr<Stream> &s,
+                                uint64_t batch) {
+    std::lock_guard<std::mutex> lk(mu_);
+    bool first = due_.empty() || at < due_.top().at;
+    due_.push({at, s, batch});
+    if (first) cv_.notify_one();
+}
+
+void GatewayCoalescer::Run() {
+    std::unique_lock<std::mutex> lk(mu_);
+    while (!stop_) {
+        if (due_.empty()) {
+            cv_.wait(lk);
+            continue;
+        }
+        if (Clock::now() < due_.top().at) {
+            cv_.wait_until(lk, due_.top().at);
+            continue;
+        }
+        Deadline d = due_.top();
+        due_.pop();
+        lk.unlock();
+        bool retry = false;
+        if (auto s = d.stream.lock()) {
+            /* Busy means the handler is in push(), which flushes an overdue
+             * batch itself; look again in case it goes quiet right after. */
+            std::unique_lock<std::mutex> slk(s->mu, std::try_to_lock);
+            if (!slk.owns_lock()) retry = true;
+            else if (!s->closed && s->has_pending && s->batch == d.batch) retry = !s->Hand();
+        }
+        lk.lock();
+        if (retry) due_.push({Clock::now() + window_, d.stream, d.batch});
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * Nebo C SDK — token coalescing for gateway streams.
+ *
+ * Internal to the C++ shim. The gateway bridge owns one GatewayCoalescer
+ * when the handler opts in, and routes every streamed push() through it.
+ */
+
+#ifndef NEBO_GATEWAY_COALESCE_H
+#define NEBO_GATEWAY_COALESCE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "proto/apps/v0/gateway.pb.h"
+
+extern "C" {
+#include "nebo/gateway.h"
+}
+
+/**
+ * Merges runs of "text" or "thinking" events into one GatewayEvent, so a
+ * stream of 1-4 byte tokens costs one write per batch instead of one per
+ * token. A token that follows no write in the last window goes out alone,
+ * so the first token is never held back. Later ones start a batch, which
+ * is written once it holds max_bytes of content, once it is window old, or
+ * as soon as an event that cannot join it arrives, so events keep their
+ * order. A single timer thread hands batches whose handler went quiet
+ * before either limit was reached to the stream's writer queue; it never
+ * waits on a stream or writes to a host itself, so one slow host cannot
+ * hold back the batches of other streams.
+ */
+class GatewayCoalescer {
+public:
+    /* Writes one event to the client; false once the call is gone. */
+    using Write = std::function<bool(const apps::v0::GatewayEvent &)>;
+    /* Queues one event for the stream's writer without waiting: 1 if it was
+     * queued, 0 if the queue is full, -1 once the call is gone. */
+    using Offer = std::function<int(const apps::v0::GatewayEvent &)>;
+    /* True once the SDK cancelled the call; checked on every push(), so it
+     * must be cheap. A hang-up is noticed when the next batch is written. */
+    using Cancelled = std::function<bool()>;
+
+    class Stream;
+
+    GatewayCoalescer(size_t max_bytes, std::chrono::milliseconds window);
+    ~GatewayCoalescer();
+
+    /**
+     * Starts coalescing one call's events. The handler's thread sends
+     * through write; the timer thread only ever uses offer.
+     */
+    std::shared_ptr<Stream> Open(Write write, Offer offer, Cancelled cancelled);
+
+    /** push() for the handler; opaque is the Stream. */
+    static int Push(const nebo_gateway_event_t *evt, void *opaque);
+
+    /** Writes what is still batched and detaches write. Returns false if it failed. */
+    static bool Close(Stream *s);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Deadline {
+        Clock::time_point at;
+        std::weak_ptr<Stream> stream;
+        uint64_t batch;
+        bool operator>(const Deadline &o) const { return at > o.at; }
+    };
+
+    void Schedule(Clock::time_point at, const std::shared_ptr<Stream> &s, uint64_t batch);
+    void Run();
+
+    size_t max_bytes_;
+    std::chrono::milliseconds window_;
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> due_;
+    bool stop_ = false;
+    std::thread timer_;
+};
+
+#endif /* NEBO_GATEWAY_COALESCE_H */
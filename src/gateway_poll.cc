@@ -0,0 +1,255 @@
+/**
+ * Nebo C SDK — buffered gateway streams for GatewayService.Poll.
+ *
+ * The ring is the only thing the handler and the poller share on the hot
+ * path. Each side parks on the buffer's condition variable only when it
+ * must wait (ring empty for Poll, full for push) and announces it in
+ * `waiting`; the other side takes the mutex to notify only when someone
+ * is parked. An asynchronous Poll is counted in `parked` instead, and a
+ * wakeup signals the poller's waker thread, which finishes it.
+ */
+
+#include "gateway_poll.h"
+
+#include <algorithm>
+
+namespace apb = apps::v0;
+
+/* A full ring re-checks this often even if no wakeup arrives. */
+static const std::chrono::milliseconds kFullRecheck(50);
+
+void nebo_gateway_event_to_proto(const nebo_gateway_event_t *evt, apb::GatewayEvent *ge) {
+    if (evt->type)       ge->set_type(evt->type);
+    if (evt->content)    ge->set_content(evt->content);
+    if (evt->model)      ge->set_model(evt->model);
+    if (evt->request_id) ge->set_request_id(evt->request_id);
+}
+
+void GatewayPoller::Buffer::Wake() {
+    /* Orders our ring update before the reads of waiting and parked; pairs
+       with waiting++ and parked++. */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load() > 0) {
+        std::lock_guard<std::mutex> lk(mu);
+        cv.notify_all();
+    }
+    if (parked.load() > 0) poller->Signal();
+}
+
+void GatewayPoller::Buffer::Cancel() {
+    cancelled = true;
+    call.Cancel();
+    Wake();
+}
+
+GatewayPoller::GatewayPoller(size_t capacity, std::chrono::milliseconds ttl)
+    : capacity_(capacity), ttl_(ttl) {
+    reaper_ = std::thread([this] { Reap(); });
+    waker_ = std::thread([this] { RunWaker(); });
+}
+
+GatewayPoller::~GatewayPoller() {
+    {
+        std::unique_lock<std::mutex> lk(mu_);
+        stop_ = true;
+        for (auto &kv : buffers_) kv.second->Cancel();
+        buffers_.clear();
+        cv_.notify_all();
+        cv_.wait(lk, [this] { return running_ == 0; });
+    }
+    reaper_.join();
+    {
+        std::lock_guard<std::mutex> lk(park_mu_);
+        park_stop_ = true;
+        park_cv_.notify_all();
+    }
+    waker_.join();
+}
+
+bool GatewayPoller::Start(const std::string &request_id, Run run) {
+    auto buf = std::make_shared<Buffer>(this, capacity_);
+    buf->last_poll = Clock::now().time_since_epoch().count();
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (stop_ || buffers_.count(request_id)) return false;
+        buffers_.emplace(request_id, buf);
+        running_++;
+        cv_.notify_all();
+    }
+    std::thread([this, buf, run] {
+        int ret;
+        {
+            CallScope scope(&buf->call);
+            ret = run(Push, buf.get());
+        }
+        buf->call.Detach(); /* no cancel callback once the handler returned */
+        if (ret != 0) {
+            nebo_gateway_event_t err = {"error", "stream error", nullptr, nullptr};
+            Push(&err, buf.get());
+        }
+        buf->finished = true;
+        buf->Wake();
+        std::lock_guard<std::mutex> lk(mu_);
+        running_--;
+        cv_.notify_all();
+    }).detach();
+    return true;
+}
+
+int GatewayPoller::Push(const nebo_gateway_event_t *evt, void *opaque) {
+    auto *b = static_cast<Buffer *>(opaque);
+    apb::GatewayEvent ge;
+    nebo_gateway_event_to_proto(evt, &ge);
+    while (!b->cancelled.load()) {
+        if (b->ring.Push(ge)) {
+            b->Wake();
+            return 0;
+        }
+        b->waiting++;
+        {
+            std::unique_lock<std::mutex> lk(b->mu);
+            b->cv.wait_for(lk, kFullRecheck, [b] { return b->cancelled || !b->ring.Full(); });
+        }
+        b->waiting--;
+    }
+    return -1;
+}
+
+std::shared_ptr<GatewayPoller::Buffer> GatewayPoller::Find(const std::string &request_id) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = buffers_.find(request_id);
+    return it == buffers_.end() ? nullptr : it->second;
+}
+
+void GatewayPoller::Collect(const std::string &request_id, const std::shared_ptr<Buffer> &b,
+                            apb::PollResponse *resp) {
+    bool done = false;
+    apb::GatewayEvent ev;
+    while (!done && b->ring.Pop(&ev)) {
+        done = ev.type() == "done";
+        *resp->add_events() = std::move(ev);
+    }
+    if (resp->events_size() > 0) b->Wake(); /* room for a push() waiting on a full ring */
+
+    bool complete = done || (b->finished && b->ring.Empty());
+    resp->set_complete(complete);
+    b->last_poll = Clock::now().time_since_epoch().count();
+    if (complete) {
+        /* A handler still pushing after "done" must not wait on a ring nobody drains. */
+        b->Cancel();
+        std::lock_guard<std::mutex> lk(mu_);
+        auto it = buffers_.find(request_id);
+        if (it != buffers_.end() && it->second == b) buffers_.erase(it);
+    }
+}
+
+grpc::Status GatewayPoller::Poll(const std::string &request_id, std::chrono::milliseconds wait,
+                                 apb::PollResponse *resp) {
+    std::shared_ptr<Buffer> b = Find(request_id);
+    if (!b) return grpc::Status(grpc::NOT_FOUND, "no buffered stream for request_id");
+    b->last_poll = Clock::now().time_since_epoch().count();
+    if (!b->Ready()) {
+        b->waiting++;
+        {
+            std::unique_lock<std::mutex> lk(b->mu);
+            b->cv.wait_for(lk, wait, [&b] { return b->Ready(); });
+        }
+        b->waiting--;
+    }
+    Collect(request_id, b, resp);
+    return grpc::Status::OK;
+}
+
+void GatewayPoller::PollAsync(const std::string &request_id, std::chrono::milliseconds wait,
+                              apb::PollResponse *resp, std::function<void(grpc::Status)> done) {
+    std::shared_ptr<Buffer> b = Find(request_id);
+    if (!b) {
+        done(grpc::Status(grpc::NOT_FOUND, "no buffered stream for request_id"));
+        return;
+    }
+    b->last_poll = Clock::now().time_since_epoch().count();
+    if (b->Ready() || wait.count() <= 0) {
+        Collect(request_id, b, resp);
+        done(grpc::Status::OK);
+        return;
+    }
+    b->parked++;
+    std::lock_guard<std::mutex> lk(park_mu_);
+    parked_.push_back(Parked{request_id, b, resp, std::move(done), Clock::now() + wait});
+    /* An event pushed before parked++ signalled nobody: have the waker look. */
+    signalled_ = true;
+    park_cv_.notify_one();
+}
+
+void GatewayPoller::Signal() {
+    std::lock_guard<std::mutex> lk(park_mu_);
+    signalled_ = true;
+    park_cv_.notify_one();
+}
+
+void GatewayPoller::RunWaker() {
+    std::vector<Parked> due;
+    std::unique_lock<std::mutex> lk(park_mu_);
+    for (;;) {
+        if (!park_stop_ && !signalled_) {
+            if (parked_.empty()) {
+                park_cv_.wait(lk);
+            } else {
+                auto next = std::min_element(parked_.begin(), parked_.end(),
+                    [](const Parked &a, const Parked &b) { return a.deadline < b.deadline; });
+                park_cv_.wait_until(lk, next->deadline);
+            }
+        }
+        signalled_ = false;
+        Clock::time_point now = Clock::now();
+        for (size_t i = 0; i < parked_.size();) {
+            Parked &p = parked_[i];
+            if (park_stop_ || p.buf->Ready() || p.deadline <= now) {
+                p.buf->parked--;
+                due.push_back(std::move(p));
+                if (&p != &parked_.back()) p = std::move(parked_.back());
+                parked_.pop_back();
+            } else {
+                i++;
+            }
+        }
+        bool stop = park_stop_;
+        lk.unlock();
+        for (Parked &p : due) {
+            Collect(p.request_id, p.buf, p.resp);
+            p.done(grpc::Status::OK);
+        }
+        due.clear();
+        if (stop) return;
+        lk.lock();
+    }
+}
+
+bool GatewayPoller::Cancel(const std::string &request_id) {
+    std::shared_ptr<Buffer> b = Find(request_id);
+    if (!b) return false;
+    b->Cancel();
+    return true;
+}
+
+void GatewayPoller::Reap() {
+    auto interval = std::min(std::max(ttl_ / 4, std::chrono::milliseconds(10)),
+                             std::chrono::milliseconds(1000));
+    std::unique_lock<std::mutex> lk(mu_);
+    while (!stop_) {
+        if (buffers_.empty()) {
+            cv_.wait(lk, [this] { return stop_ || !buffers_.empty(); });
+            continue;
+        }
+        cv_.wait_for(lk, interval);
+        Clock::rep now = Clock::now().time_since_epoch().count();
+        for (auto it = buffers_.begin(); it != buffers_.end();) {
+            if (Clock::duration(now - it->second->last_poll.load()) > ttl_) {
+                it->second->Cancel();
+                it = buffers_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
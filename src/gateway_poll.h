@@ -0,0 +1,132 @@
+/**
+ * Nebo C SDK — buffered gateway streams for GatewayService.Poll.
+ *
+ * Internal to the C++ shim. The gateway bridge owns one GatewayPoller and
+ * hands it every Stream call whose request sets poll.
+ */
+
+#ifndef NEBO_GATEWAY_POLL_H
+#define NEBO_GATEWAY_POLL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+#include "proto/apps/v0/gateway.pb.h"
+#include "call_context.h"
+#include "ring.h"
+
+extern "C" {
+#include "nebo/gateway.h"
+}
+
+/**
+ * Runs polled gateway streams and buffers their events per request_id.
+ * The handler pushes into a bounded ring without taking a lock; Poll drains
+ * it in batches. A full ring makes push() wait for the next Poll. A buffer
+ * nobody polls for ttl is reaped, and its push() starts failing. Each
+ * handler runs with a current nebo_call of its own, without a deadline,
+ * that is cancelled whenever its buffer is cancelled, reaped or completed.
+ * PollAsync parks its call with one waker thread instead of a thread of
+ * its own; the buffer's next event or the wait running out finishes it.
+ */
+class GatewayPoller {
+public:
+    /* Runs the handler with the push function and context to use. */
+    using Run = std::function<int(nebo_push_gateway_event_fn push, void *push_ctx)>;
+
+    GatewayPoller(size_t capacity, std::chrono::milliseconds ttl);
+    /** Cancels every buffered stream and waits for their handlers to return. */
+    ~GatewayPoller();
+
+    /** Starts run on its own thread. Returns false if request_id is already buffered. */
+    bool Start(const std::string &request_id, Run run);
+
+    /**
+     * Returns the buffered events of request_id, waiting up to wait for the
+     * first one. complete is set with the "done" event, or once the handler
+     * returned and everything was drained; the buffer is then released.
+     */
+    grpc::Status Poll(const std::string &request_id, std::chrono::milliseconds wait,
+                      apps::v0::PollResponse *resp);
+
+    /** Poll without blocking: done runs with the result, maybe before this returns. */
+    void PollAsync(const std::string &request_id, std::chrono::milliseconds wait,
+                   apps::v0::PollResponse *resp, std::function<void(grpc::Status)> done);
+
+    /** Makes the stream's next push() fail. Returns false if it is not buffered. */
+    bool Cancel(const std::string &request_id);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Buffer {
+        Buffer(GatewayPoller *poller, size_t capacity) : poller(poller), ring(capacity) {}
+        GatewayPoller *poller;
+        MpmcRing<apps::v0::GatewayEvent> ring;
+        std::atomic<bool> finished{false};  /* handler returned */
+        std::atomic<bool> cancelled{false};
+        std::atomic<int> waiting{0};        /* threads parked on cv */
+        std::atomic<int> parked{0};         /* PollAsync calls with the waker */
+        std::atomic<Clock::rep> last_poll;
+        std::mutex mu;                      /* only for parking on cv */
+        std::condition_variable cv;
+        nebo_call call{nullptr};            /* the handler's current call */
+
+        void Wake();
+        /** Fails push() from now on and cancels the handler's call. */
+        void Cancel();
+        /** Poll would return at once. */
+        bool Ready() const { return !ring.Empty() || finished || cancelled; }
+    };
+
+    /* A PollAsync call waiting for its buffer. */
+    struct Parked {
+        std::string request_id;
+        std::shared_ptr<Buffer> buf;
+        apps::v0::PollResponse *resp;
+        std::function<void(grpc::Status)> done;
+        Clock::time_point deadline;
+    };
+
+    static int Push(const nebo_gateway_event_t *evt, void *opaque);
+    std::shared_ptr<Buffer> Find(const std::string &request_id);
+    /** Drains b into resp and releases it once complete. */
+    void Collect(const std::string &request_id, const std::shared_ptr<Buffer> &b,
+                 apps::v0::PollResponse *resp);
+    void Signal();
+    void Reap();
+    void RunWaker();
+
+    size_t capacity_;
+    std::chrono::milliseconds ttl_;
+
+    std::mutex mu_;
+    std::condition_variable cv_;      /* reaper sleep; runner exit */
+    std::unordered_map<std::string, std::shared_ptr<Buffer>> buffers_;
+    int running_ = 0;
+    bool stop_ = false;
+    std::thread reaper_;
+
+    std::mutex park_mu_;              /* after mu_ when both are held */
+    std::condition_variable park_cv_;
+    std::vector<Parked> parked_;
+    bool signalled_ = false;
+    bool park_stop_ = false;
+    std::thread waker_;
+};
+
+/** Copies the set fields of a C gateway event into its proto. */
+void nebo_gateway_event_to_proto(const nebo_gateway_event_t *evt, apps::v0::GatewayEvent *ge);
+
+#endif /* NEBO_GATEWAY_POLL_H */
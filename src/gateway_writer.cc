@@ -0,0 +1,162 @@
+/**
+ * Nebo C SDK — queued writer for gateway streams.
+ */
+
+#include "gateway_writer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace apb = apps::v0;
+
+/* Writers by handler and request, so nebo_gateway_stream_stats can find a
+ * live stream. One entry per stream: request_ids may repeat. */
+using RegistryKey = std::pair<const nebo_gateway_handler_t *, std::string>;
+static std::mutex g_registry_mu;
+static std::multimap<RegistryKey, GatewayWriter *> g_registry;
+
+static unsigned long long since_us(std::chrono::steady_clock::time_point t) {
+    return (unsigned long long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t).count();
+}
+
+GatewayWriter::GatewayWriter(const nebo_gateway_handler_t *h, const std::string &request_id,
+                             size_t capacity, Write write)
+    : h_(h),
+      request_id_(request_id),
+      write_(std::move(write)),
+      capacity_(std::max(capacity, (size_t)1)),
+      policy_(h->write_backpressure) {
+    writer_ = std::thread([this] { Run(); });
+    std::lock_guard<std::mutex> lk(g_registry_mu);
+    g_registry.emplace(RegistryKey{h_, request_id_}, this);
+}
+
+GatewayWriter::~GatewayWriter() {
+    {
+        std::lock_guard<std::mutex> lk(g_registry_mu);
+        auto range = g_registry.equal_range({h_, request_id_});
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == this) {
+                g_registry.erase(it);
+                break;
+            }
+        }
+    }
+    Close();
+}
+
+bool GatewayWriter::Push(const apb::GatewayEvent &ev) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (failed_ || closing_) return false;
+
+    if (queue_.size() >= capacity_ && policy_ == NEBO_BACKPRESSURE_FAIL) {
+        stats_.dropped++;
+        return false;
+    }
+    if (queue_.size() >= capacity_ && policy_ == NEBO_BACKPRESSURE_DROP_OLDEST) {
+        auto it = std::find_if(queue_.begin(), queue_.end(),
+                               [](const apb::GatewayEvent &q) { return q.type() == "thinking"; });
+        if (it != queue_.end()) {
+            queue_.erase(it);
+            stats_.dropped++;
+        }
+    }
+    if (queue_.size() >= capacity_) {
+        auto since = Clock::now();
+        stats_.stalls++;
+        room_.wait(lk, [this] { return queue_.size() < capacity_ || failed_; });
+        stats_.stall_us += since_us(since);
+        if (failed_) return false;
+    }
+
+    queue_.push_back(ev);
+    stats_.depth = (int)queue_.size();
+    stats_.high_water = std::max(stats_.high_water, stats_.depth);
+    if (writer_idle_) ready_.notify_one();
+    return true;
+}
+
+int GatewayWriter::Offer(const apb::GatewayEvent &ev) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (failed_ || closing_) return -1;
+    if (queue_.size() >= capacity_) return 0;
+    queue_.push_back(ev);
+    stats_.depth = (int)queue_.size();
+    stats_.high_water = std::max(stats_.high_water, stats_.depth);
+    if (writer_idle_) ready_.notify_one();
+    return 1;
+}
+
+void GatewayWriter::Run() {
+    std::vector<apb::GatewayEvent> batch;
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+        writer_idle_ = true;
+        ready_.wait(lk, [this] { return !queue_.empty() || closing_; });
+        writer_idle_ = false;
+        if (queue_.empty()) return;
+
+        /* Take everything queued, then write without the lock. */
+        std::move(queue_.begin(), queue_.end(), std::back_inserter(batch));
+        queue_.clear();
+        stats_.depth = 0;
+        room_.notify_all();
+        lk.unlock();
+
+        bool ok = true;
+        unsigned long long slowest = 0, written = 0;
+        for (const apb::GatewayEvent &ev : batch) {
+            auto since = Clock::now();
+            ok = write_(ev);
+            slowest = std::max(slowest, since_us(since));
+            if (!ok) break;
+            written++;
+        }
+        batch.clear();
+
+        lk.lock();
+        stats_.written += written;
+        stats_.write_us_max = std::max(stats_.write_us_max, slowest);
+        if (!ok) {
+            failed_ = true;
+            queue_.clear();
+            stats_.depth = 0;
+            room_.notify_all();
+            return;
+        }
+    }
+}
+
+void GatewayWriter::Close() {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        closing_ = true;
+        ready_.notify_one();
+    }
+    if (writer_.joinable()) writer_.join();
+}
+
+bool GatewayWriter::Failed() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return failed_;
+}
+
+nebo_gateway_stream_stats_t GatewayWriter::Stats() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return stats_;
+}
+
+extern "C" int nebo_gateway_stream_stats(const nebo_gateway_handler_t *gw, const char *request_id,
+                                         nebo_gateway_stream_stats_t *out) {
+    if (!gw || !request_id || !out) return -1;
+    std::lock_guard<std::mutex> lk(g_registry_mu);
+    auto range = g_registry.equal_range({gw, request_id});
+    /* None, or several streams sharing the id: there is no one stream to report. */
+    if (range.first == range.second || std::next(range.first) != range.second) return -1;
+    *out = range.first->second->Stats();
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * Nebo C SDK — queued writer for gateway streams.
+ *
+ * Internal to the C++ shim. The gateway bridge puts one GatewayWriter
+ * between a streamed request's push() and its gRPC writer when the handler
+ * sets write_queue or coalesce_bytes.
+ */
+
+#ifndef NEBO_GATEWAY_WRITER_H
+#define NEBO_GATEWAY_WRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "proto/apps/v0/gateway.pb.h"
+
+extern "C" {
+#include "nebo/gateway.h"
+}
+
+/**
+ * Bounded queue drained by its own writer thread, so a host that reads
+ * slowly holds up the writer rather than the handler's upstream read loop.
+ * When the queue is full, Push follows the handler's backpressure policy:
+ * wait for room, drop the oldest "thinking" event (waiting if there is
+ * none), or refuse the event.
+ */
+class GatewayWriter {
+public:
+    /* Writes one event to the client; false once the call is gone. */
+    using Write = std::function<bool(const apps::v0::GatewayEvent &)>;
+
+    GatewayWriter(const nebo_gateway_handler_t *h, const std::string &request_id, size_t capacity,
+                  Write write);
+    /** Closes the writer if Close was not called. */
+    ~GatewayWriter();
+
+    /** Queues ev. Returns false if it was refused or the call is gone. */
+    bool Push(const apps::v0::GatewayEvent &ev);
+
+    /**
+     * Queues ev without waiting, whatever the backpressure policy. Returns
+     * 1 if it was queued, 0 if the queue is full, -1 once the call is gone.
+     */
+    int Offer(const apps::v0::GatewayEvent &ev);
+
+    /** Writes everything still queued, then stops the writer thread. */
+    void Close();
+
+    /** True once a write failed; later pushes fail too. */
+    bool Failed();
+
+    nebo_gateway_stream_stats_t Stats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void Run();
+
+    const nebo_gateway_handler_t *h_;
+    std::string request_id_;
+    Write write_;
+    size_t capacity_;
+    nebo_backpressure_t policy_;
+
+    std::mutex mu_;
+    std::condition_variable ready_;  /* writer: queue non-empty or closing */
+    std::condition_variable room_;   /* push(): queue has room or failed */
+    std::deque<apps::v0::GatewayEvent> queue_;
+    bool writer_idle_ = false;
+    bool closing_ = false;
+    bool failed_ = false;
+    nebo_gateway_stream_stats_t stats_{};
+    std::thread writer_;
+};
+
+#endif /* NEBO_GATEWAY_WRITER_H */
@@ -2,15 +2,39 @@
  * Nebo C SDK — gRPC server (C++ shim).
  *
  * Implements six gRPC service bridges that call through to C handler
- * function pointers. The public SDK API stays 100% C; this file is the
- * only C++ in the library.
+ * function pointers. The public SDK API stays 100% C; the C++ is confined
+ * to this file and its internal helpers (tool_cache.cc, tool_admission.cc,
+ * static_assets.cc, http_cache.cc, gateway_poll.cc,
+ * gateway_coalesce.cc, gateway_writer.cc).
+ *
+ * The bridges are engine-independent. Two engines expose them over gRPC:
+ *   NEBO_ENGINE_SYNC      — classic sync services; every call (including
+ *                           long-lived streams) occupies a gRPC pool thread.
+ *   NEBO_ENGINE_CALLBACK  — callback services; unary handlers run on a fixed
+ *                           SDK worker pool and stream handlers on their own
+ *                           threads, so streams never hold a polling thread.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <string>
 #include <csignal>
 #include <unistd.h>
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <grpcpp/grpcpp.h>
 
 #include "proto/apps/v0/common.grpc.pb.h"
@@ -21,8 +45,19 @@
 #include "proto/apps/v0/comm.grpc.pb.h"
 #include "proto/apps/v0/schedule.grpc.pb.h"
 
+#include "tool_admission.h"
+#include "tool_cache.h"
+#include "static_assets.h"
+#include "http_cache.h"
+#include "gateway_coalesce.h"
+#include "gateway_poll.h"
+#include "gateway_writer.h"
+
 extern "C" {
 #include "internal.h"
+#include "hash.h"
+#include "json_writer.h"
+#include "call_context.h"
 }
 
 namespace apb = apps::v0;
@@ -69,45 +104,430 @@ static nebo_string_map_t proto_map_to_c(const google::protobuf::Map<std::string,
     return {*out_keys, *out_vals, n};
 }
 
-/* ── ToolBridge ──────────────────────────────────────────────────────── */
+/**
+ * Write side of a server-streaming call. Each engine supplies its own
+ * implementation; the push trampolines only see this interface.
+ */
+template <class Msg>
+class StreamSink {
+public:
+    virtual ~StreamSink() = default;
+    virtual bool IsCancelled() = 0;
+    virtual bool Write(const Msg &msg) = 0;
+};
 
-class ToolBridge final : public apb::ToolService::Service {
-    const nebo_tool_handler_t *h_;
-    const nebo_app_t *app_;
+/**
+ * Both directions of a bidi-streaming call. Read() blocks for the next
+ * message and returns false once the client half-closed or the call ended.
+ */
+template <class In, class Out>
+class BidiStream : public StreamSink<Out> {
 public:
-    ToolBridge(const nebo_tool_handler_t *h, const nebo_app_t *app) : h_(h), app_(app) {}
+    virtual bool Read(In *msg) = 0;
+};
 
-    grpc::Status HealthCheck(grpc::ServerContext *, const apb::HealthCheckRequest *,
-                             apb::HealthCheckResponse *resp) override {
-        return health_ok(resp, app_);
+/**
+ * Fixed-size thread pool. The callback engine runs unary C handlers on one
+ * sized by the app's thread count; ExecuteBatch fans out on another.
+ */
+class WorkerPool {
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> queue_;
+    std::vector<std::thread> threads_;
+    bool stop_ = false;
+
+    void Run() {
+        for (;;) {
+            std::function<void()> fn;
+            {
+                std::unique_lock<std::mutex> lock(mu_);
+                cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                if (queue_.empty()) return;
+                fn = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            fn();
+        }
+    }
+public:
+    explicit WorkerPool(int n) {
+        for (int i = 0; i < n; i++) threads_.emplace_back([this] { Run(); });
     }
 
-    grpc::Status Name(grpc::ServerContext *, const apb::Empty *,
-                      apb::NameResponse *resp) override {
-        if (h_->name) resp->set_name(h_->name);
-        return grpc::Status::OK;
+    /* Drains queued work, then joins. */
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto &t : threads_) t.join();
     }
 
-    grpc::Status Description(grpc::ServerContext *, const apb::Empty *,
-                             apb::DescriptionResponse *resp) override {
-        if (h_->description) resp->set_description(h_->description);
-        return grpc::Status::OK;
+    void Submit(std::function<void()> fn) {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            queue_.push_back(std::move(fn));
+        }
+        cv_.notify_one();
+    }
+};
+
+/* ── ToolBridge ──────────────────────────────────────────────────────── */
+
+/** Output sink for execute_buf and async handlers: the response's own content. */
+struct nebo_tool_output {
+    apb::ExecuteResponse *resp;
+};
+
+extern "C" void nebo_tool_output_reserve(nebo_tool_output_t *out, size_t capacity) {
+    if (out) out->resp->mutable_content()->reserve(capacity);
+}
+
+extern "C" void nebo_tool_output_write(nebo_tool_output_t *out, const void *data, size_t len) {
+    if (out && len > 0) out->resp->mutable_content()->append(static_cast<const char *>(data), len);
+}
+
+extern "C" char *nebo_tool_output_extend(nebo_tool_output_t *out, size_t len) {
+    if (!out) return nullptr;
+    std::string *content = out->resp->mutable_content();
+    size_t pos = content->size();
+    content->resize(pos + len);
+    return &(*content)[pos];
+}
+
+extern "C" void nebo_tool_output_set_error(nebo_tool_output_t *out, int is_error) {
+    if (out) out->resp->set_is_error(is_error);
+}
+
+/*
+ * JSON writer sink over the response content. The string is kept resized to
+ * base + cap, so the writer fills it in place; close() trims it back to
+ * what was written (or to base when the document is discarded).
+ */
+static int OutputJsonGrow(nebo_json_writer_t *w, size_t need) {
+    auto *content = static_cast<nebo_tool_output *>(w->sink.ctx)->resp->mutable_content();
+    size_t base = content->size() - w->cap;
+    size_t cap = std::max<size_t>(w->cap * 2, 256);
+    while (cap - w->len < need) cap *= 2;
+    content->resize(base + cap);
+    w->buf = &(*content)[base];
+    w->cap = cap;
+    return 0;
+}
+
+static void OutputJsonClose(nebo_json_writer_t *w, int ok) {
+    auto *content = static_cast<nebo_tool_output *>(w->sink.ctx)->resp->mutable_content();
+    size_t base = content->size() - w->cap;
+    content->resize(base + (ok ? w->len : 0));
+}
+
+extern "C" nebo_json_writer_t *nebo_tool_output_json(nebo_tool_output_t *out) {
+    if (!out) return nullptr;
+    nebo_json_sink_t sink = {OutputJsonGrow, OutputJsonClose, out};
+    return nebo_json_writer_new_sink(&sink);
+}
+
+/**
+ * Pending async execution. Owned by the handler from execute_async() until
+ * it calls nebo_tool_complete() or nebo_tool_fail(), which free it.
+ */
+struct nebo_tool_completion {
+    nebo_tool_completion(grpc::ServerContextBase *ctx, apb::ExecuteResponse *resp,
+                         std::function<void(grpc::Status)> finish)
+        : out{resp}, finish(std::move(finish)), call(ctx) {}
+
+    nebo_tool_output out;
+    std::function<void(grpc::Status)> finish;
+    nebo_call call;
+};
+
+extern "C" nebo_tool_output_t *nebo_tool_completion_output(nebo_tool_completion_t *done) {
+    return done ? &done->out : nullptr;
+}
+
+extern "C" nebo_call_t *nebo_tool_completion_call(nebo_tool_completion_t *done) {
+    return done ? &done->call : nullptr;
+}
+
+extern "C" void nebo_tool_complete(nebo_tool_completion_t *done, const char *output, int is_error) {
+    if (!done) return;
+    done->call.Detach(); /* no cancel callback once the RPC can finish */
+    if (output) done->out.resp->set_content(output);
+    done->out.resp->set_is_error(is_error);
+    done->finish(grpc::Status::OK);
+    delete done;
+}
+
+extern "C" void nebo_tool_fail(nebo_tool_completion_t *done, const char *message) {
+    if (!done) return;
+    done->call.Detach();
+    done->finish(grpc::Status(grpc::INTERNAL, message ? message : "execute failed"));
+    delete done;
+}
+
+/** An ExecuteStream as the push trampoline sees it. */
+struct ToolStreamOut {
+    StreamSink<apb::ExecuteChunk> *sink;
+    uint64_t queue_wait_us; /* sent with the first chunk, then cleared */
+};
+
+static int tool_chunk_trampoline(const nebo_tool_chunk_t *chunk, void *opaque) {
+    auto *out = static_cast<ToolStreamOut *>(opaque);
+    if (out->sink->IsCancelled()) return -1;
+    apb::ExecuteChunk c;
+    if (chunk->data && chunk->len) c.set_content(chunk->data, chunk->len);
+    c.set_is_error(chunk->is_error != 0);
+    c.set_queue_wait_us(out->queue_wait_us);
+    out->queue_wait_us = 0;
+    return out->sink->Write(c) ? 0 : -1;
+}
+
+/* CANCELLED or DEADLINE_EXCEEDED once ctx's call is over, else OK. */
+static grpc::Status call_status(grpc::ServerContextBase *ctx) {
+    gpr_timespec raw = ctx->raw_deadline();
+    if (gpr_time_cmp(raw, gpr_inf_future(raw.clock_type)) != 0 &&
+        ctx->deadline() <= std::chrono::system_clock::now())
+        return grpc::Status(grpc::DEADLINE_EXCEEDED, "deadline exceeded");
+    if (ctx->IsCancelled()) return grpc::Status(grpc::CANCELLED, "call cancelled");
+    return grpc::Status::OK;
+}
+
+/** A queued call's watch on its RPC; see enter_watched(). */
+struct QueueWatch : std::enable_shared_from_this<QueueWatch> {
+    explicit QueueWatch(grpc::ServerContextBase *ctx) : call(ctx) {}
+    ~QueueWatch() { call.Detach(); } /* before the members the callback reads go */
+
+    nebo_call call;
+    ToolAdmission *adm = nullptr;
+    uint64_t ticket = 0;
+    std::function<void(grpc::Status)> abandoned;
+    std::mutex mu;
+    bool resumed = false;
+};
+
+static void queue_watch_fired(void *opaque) {
+    auto w = static_cast<QueueWatch *>(opaque)->weak_from_this().lock();
+    if (w && w->adm->Cancel(w->ticket)) w->abandoned(call_status(w->call.ctx));
+}
+
+/**
+ * adm->Enter(resume) for ctx's call. While the call is queued the cancel
+ * watcher keeps an eye on its RPC: if the host hangs up or the deadline
+ * passes first, the call leaves the queue and abandoned runs with the
+ * reason instead of resume. On kQueued exactly one of the two runs later.
+ */
+static ToolAdmission::Result enter_watched(grpc::ServerContextBase *ctx, ToolAdmission *adm,
+                                           ToolAdmission::Resume resume,
+                                           std::function<void(grpc::Status)> abandoned) {
+    auto w = std::make_shared<QueueWatch>(ctx);
+    w->adm = adm;
+    w->abandoned = std::move(abandoned);
+    ToolAdmission::Result r = adm->Enter([w, resume](uint64_t wait_us) {
+        {
+            std::lock_guard<std::mutex> lk(w->mu);
+            w->resumed = true;
+        }
+        w->call.Detach();
+        resume(wait_us);
+    }, &w->ticket);
+    if (r == ToolAdmission::kQueued) {
+        std::lock_guard<std::mutex> lk(w->mu);
+        if (!w->resumed) nebo_call_on_cancel(&w->call, queue_watch_fired, w.get());
     }
+    return r;
+}
 
-    grpc::Status Schema(grpc::ServerContext *, const apb::Empty *,
-                        apb::SchemaResponse *resp) override {
-        if (h_->schema) resp->set_schema(h_->schema, strlen(h_->schema));
+/**
+ * Takes a slot of adm for a caller that can wait on its own thread. OK:
+ * the caller holds the slot and *wait_us is the time it spent queued.
+ * Otherwise it was rejected or its call ended while queued, and it holds
+ * nothing.
+ */
+static grpc::Status wait_for_slot(grpc::ServerContextBase *ctx, ToolAdmission *adm,
+                                  const char *tool, uint64_t *wait_us) {
+    std::promise<grpc::Status> turn;
+    switch (enter_watched(ctx, adm,
+                          [&turn, wait_us](uint64_t w) {
+                              *wait_us = w;
+                              turn.set_value(grpc::Status::OK);
+                          },
+                          [&turn](grpc::Status st) { turn.set_value(st); })) {
+    case ToolAdmission::kRun:
+        *wait_us = 0;
         return grpc::Status::OK;
+    case ToolAdmission::kFull:
+        return grpc::Status(grpc::RESOURCE_EXHAUSTED, "tool busy: " + std::string(tool));
+    case ToolAdmission::kQueued:
+        break;
+    }
+    return turn.get_future().get();
+}
+
+/** Per-tool state held by the bridge. */
+struct ToolEntry {
+    const nebo_tool_handler_t *h;
+    std::shared_ptr<ToolCache> cache;         /* set when h->cache */
+    std::shared_ptr<ToolAdmission> admission; /* set when h->max_in_flight > 0 */
+    uint64_t fingerprint;                     /* content hash of h->schema, never 0 */
+    std::string schema_resp;                  /* serialized SchemaResponse */
+    std::string unchanged_resp;               /* ... with not_modified set instead */
+};
+
+/* Wraps bytes that outlive the call in a response without copying them. */
+static grpc::ByteBuffer StaticBuffer(const std::string &bytes) {
+    grpc::Slice slice(bytes.data(), bytes.size(), grpc::Slice::STATIC_SLICE);
+    return grpc::ByteBuffer(&slice, 1);
+}
+
+template <class Msg>
+static bool ParseBuffer(const grpc::ByteBuffer *buf, Msg *msg) {
+    grpc::ByteBuffer copy(*buf); /* Deserialize consumes its input; this only takes a ref */
+    return grpc::SerializationTraits<Msg>::Deserialize(&copy, msg).ok();
+}
+
+/**
+ * Name → tool lookup for Execute. Open addressing with linear probing over a
+ * power-of-two table kept at most half full, so a lookup is one hash and
+ * usually one compare. Built once before serving and read-only afterwards.
+ */
+class ToolTable {
+    struct Slot {
+        uint64_t hash;
+        const ToolEntry *tool; /* nullptr = empty */
+    };
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+public:
+    explicit ToolTable(const std::vector<ToolEntry> &tools) {
+        size_t cap = 2;
+        while (cap < tools.size() * 2) cap <<= 1;
+        slots_.assign(cap, Slot{0, nullptr});
+        mask_ = cap - 1;
+        for (const ToolEntry &t : tools) {
+            if (!t.h->name) continue;
+            uint64_t hash = nebo_fnv1a(t.h->name, strlen(t.h->name));
+            size_t i = hash & mask_;
+            while (slots_[i].tool) i = (i + 1) & mask_;
+            slots_[i] = Slot{hash, &t};
+        }
+    }
+
+    const ToolEntry *Find(const std::string &name) const {
+        uint64_t hash = nebo_fnv1a(name.data(), name.size());
+        for (size_t i = hash & mask_; slots_[i].tool; i = (i + 1) & mask_) {
+            if (slots_[i].hash == hash && name == slots_[i].tool->h->name) return slots_[i].tool;
+        }
+        return nullptr;
+    }
+};
+
+class ToolBridge final {
+    /* Slice size when replaying a buffered result over ExecuteStream. */
+    static constexpr size_t kStreamSlice = 1 << 20;
+
+    std::vector<ToolEntry> tools_; /* never resized after construction; the table points into it */
+    ToolTable table_;
+    const nebo_app_t *app_;
+    /* Where queued async executions resume; null = the thread that frees the slot. */
+    std::function<void(std::function<void()>)> dispatch_;
+    std::once_flag batch_once_;
+    std::unique_ptr<WorkerPool> batch_pool_;
+    int batch_threads_ = 1;
+    std::string name_resp_;        /* serialized NameResponse */
+    std::string description_resp_; /* serialized DescriptionResponse */
+
+    static std::vector<ToolEntry> entries(const nebo_tool_handler_t *const *tools, int count) {
+        std::vector<ToolEntry> v;
+        for (int i = 0; i < count; i++) {
+            const nebo_tool_handler_t *h = tools[i];
+            std::shared_ptr<ToolCache> cache;
+            std::shared_ptr<ToolAdmission> admission;
+            if (h->cache) cache = std::make_shared<ToolCache>(h, h->cache_max_bytes, h->cache_ttl_ms);
+            if (h->max_in_flight > 0)
+                admission = std::make_shared<ToolAdmission>(h, h->max_in_flight, h->max_queued);
+            v.push_back(ToolEntry{h, std::move(cache), std::move(admission), 0, {}, {}});
+            Describe(&v.back());
+        }
+        return v;
+    }
+
+    /* Fingerprints the schema and pre-serializes both Schema answers. */
+    static void Describe(ToolEntry *t) {
+        const char *schema = t->h->schema ? t->h->schema : "";
+        size_t len = strlen(schema);
+        t->fingerprint = nebo_fnv1a(schema, len);
+        if (t->fingerprint == 0) t->fingerprint = 1; /* 0 means "none" on the wire */
+        apb::SchemaResponse resp;
+        resp.set_fingerprint(t->fingerprint);
+        resp.set_not_modified(true);
+        resp.SerializeToString(&t->unchanged_resp);
+        resp.set_not_modified(false);
+        resp.set_schema(schema, len);
+        resp.SerializeToString(&t->schema_resp);
+    }
+
+    static std::string Serialized(const google::protobuf::MessageLite &msg) {
+        std::string out;
+        msg.SerializeToString(&out);
+        return out;
     }
 
-    grpc::Status Execute(grpc::ServerContext *, const apb::ExecuteRequest *req,
-                         apb::ExecuteResponse *resp) override {
-        if (!h_->execute) return grpc::Status(grpc::UNIMPLEMENTED, "no execute handler");
+    /* Empty name selects the default (first registered) tool. */
+    const ToolEntry *Find(const std::string &name) const {
+        return name.empty() ? &tools_[0] : table_.Find(name);
+    }
+
+    using InputPtr = std::unique_ptr<nebo_input_t, void (*)(nebo_input_t *)>;
+
+    /**
+     * Checks the input against the tool's validator, if any. On failure the
+     * call is answered with an is_error result and false is returned; on
+     * success *in holds the typed view (null when there is no validator).
+     */
+    static bool Validate(const nebo_tool_handler_t *h, const std::string &input,
+                         InputPtr *in, std::string *why) {
+        if (!h->validator) return true;
+        char err[256];
+        in->reset(nebo_input_parse(h->validator, input.data(), input.size(), err, sizeof(err)));
+        if (*in) return true;
+        *why = std::string("invalid input: ") + (err[0] ? err : "out of memory");
+        return false;
+    }
+
+    grpc::Status Run(grpc::ServerContextBase *ctx, const ToolEntry *t, const apb::ExecuteRequest *req,
+                     apb::ExecuteResponse *resp) {
+        const nebo_tool_handler_t *h = t->h;
+        if (h->execute_async) {
+            /* Sync engine: park this thread until the handler completes. */
+            std::promise<grpc::Status> result;
+            RunAsync(ctx, t, req, resp, [&result](grpc::Status s) { result.set_value(s); });
+            return result.get_future().get();
+        }
+        /* Queued and batched calls get here off the RPC's own thread. */
+        ScopedCall call(ctx);
+        InputPtr in(nullptr, nebo_input_free);
+        std::string why;
+        if (!Validate(h, req->input(), &in, &why)) {
+            resp->set_content(why);
+            resp->set_is_error(true);
+            return grpc::Status::OK;
+        }
+        if (h->execute_buf) {
+            nebo_tool_output out{resp};
+            int ret = h->execute_buf(req->input().c_str(), req->input().size(), &out);
+            if (ret != 0) return grpc::Status(grpc::INTERNAL, "execute failed");
+            return grpc::Status::OK;
+        }
+        if (!h->execute && !(in && h->execute_input))
+            return grpc::Status(grpc::UNIMPLEMENTED, "no execute handler");
 
-        std::string input(req->input().begin(), req->input().end());
+        /* bytes fields are std::string, so the input is already NUL-terminated. */
         char *output = nullptr;
         int is_error = 0;
-        int ret = h_->execute(input.c_str(), &output, &is_error);
+        int ret = in && h->execute_input ? h->execute_input(in.get(), &output, &is_error)
+                                         : h->execute(req->input().c_str(), &output, &is_error);
         if (ret != 0) {
             return grpc::Status(grpc::INTERNAL, output ? output : "execute failed");
         }
@@ -119,14 +539,340 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status RequiresApproval(grpc::ServerContext *, const apb::Empty *,
-                                  apb::ApprovalResponse *resp) override {
-        resp->set_requires_approval(h_->requires_approval ? h_->requires_approval() : 0);
+    void RunAsync(grpc::ServerContextBase *ctx, const ToolEntry *t, const apb::ExecuteRequest *req,
+                  apb::ExecuteResponse *resp, std::function<void(grpc::Status)> finish) {
+        if (!t->h->execute_async) {
+            finish(Run(ctx, t, req, resp));
+            return;
+        }
+        InputPtr in(nullptr, nebo_input_free);
+        std::string why;
+        if (!Validate(t->h, req->input(), &in, &why)) {
+            resp->set_content(why);
+            resp->set_is_error(true);
+            finish(grpc::Status::OK);
+            return;
+        }
+        auto *done = new nebo_tool_completion(ctx, resp, std::move(finish));
+        CallScope scope(&done->call); /* done may be gone when execute_async returns */
+        if (t->h->execute_async(req->input().c_str(), req->input().size(), done) != 0) {
+            done->call.Detach();
+            done->finish(grpc::Status(grpc::INTERNAL, "execute failed"));
+            delete done;
+        }
+    }
+
+    /**
+     * Runs under the tool's in-flight limit, queueing or rejecting when it is
+     * reached. block: the caller waits for finish anyway, so a queued call
+     * resumes on the calling thread instead of through dispatch_.
+     */
+    void RunAdmitted(grpc::ServerContextBase *ctx, const ToolEntry *t, const apb::ExecuteRequest *req,
+                     apb::ExecuteResponse *resp, std::function<void(grpc::Status)> finish,
+                     bool block) {
+        ToolAdmission *adm = t->admission.get();
+        if (!adm) {
+            RunAsync(ctx, t, req, resp, std::move(finish));
+            return;
+        }
+        auto start = [this, ctx, t, req, resp, adm, finish](uint64_t wait_us) {
+            resp->set_queue_wait_us(wait_us);
+            grpc::Status gone = call_status(ctx);
+            if (!gone.ok()) {
+                finish(gone);
+                adm->Leave();
+                return;
+            }
+            RunAsync(ctx, t, req, resp, [adm, finish](grpc::Status s) {
+                finish(s);
+                adm->Leave();
+            });
+        };
+        if (block) {
+            uint64_t wait_us = 0;
+            grpc::Status st = wait_for_slot(ctx, adm, t->h->name, &wait_us);
+            if (st.ok()) start(wait_us);
+            else         finish(st);
+            return;
+        }
+        ToolAdmission::Resume resume = start;
+        if (dispatch_) resume = [this, start](uint64_t w) { dispatch_([start, w] { start(w); }); };
+        switch (enter_watched(ctx, adm, std::move(resume), finish)) {
+        case ToolAdmission::kRun:
+            start(0);
+            return;
+        case ToolAdmission::kFull:
+            finish(grpc::Status(grpc::RESOURCE_EXHAUSTED, "tool busy: " + std::string(t->h->name)));
+            return;
+        case ToolAdmission::kQueued:
+            return; /* start or finish runs when the call leaves the queue */
+        }
+    }
+
+    /* Hits finish inline; identical in-flight calls wait on the leader. */
+    void RunCached(grpc::ServerContextBase *ctx, const ToolEntry *t, const apb::ExecuteRequest *req,
+                   apb::ExecuteResponse *resp, std::function<void(grpc::Status)> finish,
+                   bool block) {
+        t->cache->Execute(req->input(), resp, std::move(finish),
+            [this, ctx, t, req, block](apb::ExecuteResponse *r, ToolCache::Finish f, bool promoted) {
+                if (!promoted) {
+                    RunAdmitted(ctx, t, req, r, std::move(f), block);
+                    return;
+                }
+                /* Not on the failed leader's thread: its own caller may still be waiting on it. */
+                auto go = [this, ctx, t, req, r, f] { RunAdmitted(ctx, t, req, r, f, false); };
+                if (dispatch_) dispatch_(go);
+                else           std::thread(go).detach();
+            });
+    }
+
+    /* Created on the first batch so apps that never batch start no threads. */
+    WorkerPool *BatchPool() {
+        std::call_once(batch_once_, [this] {
+            batch_threads_ = app_->batch_threads > 0 ? app_->batch_threads
+                                                     : (int)std::thread::hardware_concurrency();
+            if (batch_threads_ < 1) batch_threads_ = 1;
+            /* The calling thread runs one lane itself. */
+            if (batch_threads_ > 1) batch_pool_.reset(new WorkerPool(batch_threads_ - 1));
+        });
+        return batch_pool_.get();
+    }
+
+    /**
+     * Runs every call of a batch through Execute with at most parallelism
+     * calls in flight, reporting each result to done from the lane that ran
+     * it. done returning false stops the batch: calls not yet started are
+     * skipped and never reported. Returns once every started call has been
+     * reported.
+     */
+    void RunBatch(grpc::ServerContextBase *ctx, const apb::ExecuteBatchRequest *req,
+                  const std::function<bool(int, apb::ExecuteResponse *, const grpc::Status &)> &done) {
+        int n = req->calls_size();
+        if (n == 0) return;
+        WorkerPool *pool = BatchPool();
+        int lanes = batch_threads_;
+        if (req->parallelism() > 0 && req->parallelism() < lanes) lanes = req->parallelism();
+        if (lanes > n) lanes = n;
+
+        std::atomic<int> next{0};
+        std::atomic<bool> stopped{false};
+        auto lane = [&] {
+            for (int i; !stopped.load(std::memory_order_relaxed) && (i = next.fetch_add(1)) < n;) {
+                apb::ExecuteResponse resp;
+                grpc::Status st = ctx->IsCancelled()
+                    ? grpc::Status(grpc::CANCELLED, "batch cancelled")
+                    : Execute(ctx, &req->calls(i), &resp);
+                if (!done(i, &resp, st)) stopped.store(true, std::memory_order_relaxed);
+            }
+        };
+
+        std::mutex mu;
+        std::condition_variable cv;
+        int running = lanes - 1;
+        for (int l = 1; l < lanes; l++) {
+            pool->Submit([&] {
+                lane();
+                std::lock_guard<std::mutex> lock(mu);
+                if (--running == 0) cv.notify_one();
+            });
+        }
+        lane();
+        std::unique_lock<std::mutex> lock(mu);
+        cv.wait(lock, [&] { return running == 0; });
+    }
+
+    static void fill_result(apb::ExecuteBatchResult *r, int index, apb::ExecuteResponse *resp,
+                            const grpc::Status &st) {
+        r->set_index(index);
+        r->mutable_response()->Swap(resp);
+        r->set_code(st.error_code());
+        if (!st.ok()) r->set_error(st.error_message());
+    }
+public:
+    ToolBridge(const nebo_tool_handler_t *const *tools, const nebo_app_t *app)
+        : tools_(entries(tools, app->tool_count)), table_(tools_), app_(app) {
+        apb::NameResponse name;
+        if (tools_[0].h->name) name.set_name(tools_[0].h->name);
+        name_resp_ = Serialized(name);
+        apb::DescriptionResponse desc;
+        if (tools_[0].h->description) desc.set_description(tools_[0].h->description);
+        description_resp_ = Serialized(desc);
+    }
+
+    grpc::Status HealthCheck(grpc::ServerContextBase *, const apb::HealthCheckRequest *,
+                             apb::HealthCheckResponse *resp) {
+        return health_ok(resp, app_);
+    }
+
+    /*
+     * Name, Description and Schema answer with responses serialized at
+     * startup: the services register them as raw methods, so a call costs
+     * no message build, copy or serialization.
+     */
+    grpc::Status Name(grpc::ServerContextBase *, const grpc::ByteBuffer *, grpc::ByteBuffer *resp) {
+        *resp = StaticBuffer(name_resp_);
+        return grpc::Status::OK;
+    }
+
+    grpc::Status Description(grpc::ServerContextBase *, const grpc::ByteBuffer *,
+                             grpc::ByteBuffer *resp) {
+        *resp = StaticBuffer(description_resp_);
+        return grpc::Status::OK;
+    }
+
+    grpc::Status Schema(grpc::ServerContextBase *, const grpc::ByteBuffer *req,
+                        grpc::ByteBuffer *resp) {
+        apb::SchemaRequest r;
+        if (!ParseBuffer(req, &r)) return grpc::Status(grpc::INVALID_ARGUMENT, "bad SchemaRequest");
+        const ToolEntry *t = Find(r.tool());
+        if (!t) return grpc::Status(grpc::NOT_FOUND, "unknown tool: " + r.tool());
+        *resp = StaticBuffer(r.if_none_match() == t->fingerprint ? t->unchanged_resp : t->schema_resp);
+        return grpc::Status::OK;
+    }
+
+    grpc::Status Execute(grpc::ServerContextBase *ctx, const apb::ExecuteRequest *req,
+                         apb::ExecuteResponse *resp) {
+        const ToolEntry *t = Find(req->tool());
+        if (!t) return grpc::Status(grpc::NOT_FOUND, "unknown tool: " + req->tool());
+        if (!t->cache && !t->admission) return Run(ctx, t, req, resp);
+        std::promise<grpc::Status> result;
+        auto finish = [&result](grpc::Status s) { result.set_value(s); };
+        if (t->cache) RunCached(ctx, t, req, resp, finish, true);
+        else          RunAdmitted(ctx, t, req, resp, finish, true);
+        return result.get_future().get();
+    }
+
+    /**
+     * Starts an execution and returns without waiting for async handlers.
+     * finish is called exactly once, possibly from another thread.
+     */
+    void ExecuteAsync(grpc::ServerContextBase *ctx, const apb::ExecuteRequest *req,
+                      apb::ExecuteResponse *resp, std::function<void(grpc::Status)> finish) {
+        const ToolEntry *t = Find(req->tool());
+        if (!t) {
+            finish(grpc::Status(grpc::NOT_FOUND, "unknown tool: " + req->tool()));
+            return;
+        }
+        if (t->cache) RunCached(ctx, t, req, resp, std::move(finish), false);
+        else          RunAdmitted(ctx, t, req, resp, std::move(finish), false);
+    }
+
+    /**
+     * Makes queued executions resume through dispatch instead of on the
+     * thread that waited for them. Set before serving.
+     */
+    void SetDispatcher(std::function<void(std::function<void()>)> dispatch) {
+        dispatch_ = std::move(dispatch);
+    }
+
+    /**
+     * Streams the output of execute_stream handlers chunk by chunk. Other
+     * tools run as for Execute and their result is sent in slices.
+     */
+    grpc::Status ExecuteStream(grpc::ServerContextBase *ctx, const apb::ExecuteRequest *req,
+                               StreamSink<apb::ExecuteChunk> *sink) {
+        const ToolEntry *t = Find(req->tool());
+        if (!t) return grpc::Status(grpc::NOT_FOUND, "unknown tool: " + req->tool());
+
+        if (!t->h->execute_stream) {
+            apb::ExecuteResponse resp;
+            grpc::Status st = Execute(ctx, req, &resp);
+            if (!st.ok()) return st;
+            const std::string &out = resp.content();
+            size_t off = 0;
+            do {
+                size_t n = std::min(out.size() - off, kStreamSlice);
+                apb::ExecuteChunk c;
+                c.set_content(out.data() + off, n);
+                c.set_is_error(resp.is_error());
+                if (off == 0) c.set_queue_wait_us(resp.queue_wait_us());
+                if (!sink->Write(c)) return grpc::Status(grpc::CANCELLED, "stream closed");
+                off += n;
+            } while (off < out.size());
+            return grpc::Status::OK;
+        }
+
+        InputPtr in(nullptr, nebo_input_free);
+        std::string why;
+        if (!Validate(t->h, req->input(), &in, &why)) {
+            apb::ExecuteChunk c;
+            c.set_content(why);
+            c.set_is_error(true);
+            sink->Write(c);
+            return grpc::Status::OK;
+        }
+
+        ToolStreamOut out{sink, 0};
+        ToolAdmission *adm = t->admission.get();
+        if (adm) {
+            /* Stream handlers run on their own thread, so waiting here is fine. */
+            grpc::Status st = wait_for_slot(ctx, adm, t->h->name, &out.queue_wait_us);
+            if (!st.ok()) return st;
+        }
+        int ret = t->h->execute_stream(req->input().c_str(), req->input().size(),
+                                       tool_chunk_trampoline, &out);
+        if (adm) adm->Leave();
+        if (sink->IsCancelled()) return grpc::Status(grpc::CANCELLED, "stream cancelled");
+        return ret == 0 ? grpc::Status::OK : grpc::Status(grpc::INTERNAL, "execute failed");
+    }
+
+    grpc::Status ExecuteBatch(grpc::ServerContextBase *ctx, const apb::ExecuteBatchRequest *req,
+                              apb::ExecuteBatchResponse *resp) {
+        int n = req->calls_size();
+        resp->mutable_results()->Reserve(n);
+        for (int i = 0; i < n; i++) resp->add_results();
+        /* Each lane fills its own slot; no lock needed. */
+        RunBatch(ctx, req, [resp](int i, apb::ExecuteResponse *r, const grpc::Status &st) {
+            fill_result(resp->mutable_results(i), i, r, st);
+            return true;
+        });
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ExecuteBatchStream(grpc::ServerContextBase *ctx, const apb::ExecuteBatchRequest *req,
+                                    StreamSink<apb::ExecuteBatchResult> *sink) {
+        std::mutex write_mu;
+        bool closed = false;
+        RunBatch(ctx, req, [ctx, sink, &write_mu, &closed](int i, apb::ExecuteResponse *r,
+                                                           const grpc::Status &st) {
+            apb::ExecuteBatchResult result;
+            fill_result(&result, i, r, st);
+            std::lock_guard<std::mutex> lock(write_mu);
+            if (!closed && sink->Write(result)) return true;
+            /* Nobody reads the rest: stop dispatching, and let calls still
+             * running see nebo_call_is_cancelled(). */
+            if (!closed) ctx->TryCancel();
+            closed = true;
+            return false;
+        });
+        if (closed || sink->IsCancelled()) return grpc::Status(grpc::CANCELLED, "stream cancelled");
+        return grpc::Status::OK;
+    }
+
+    grpc::Status RequiresApproval(grpc::ServerContextBase *, const apb::Empty *,
+                                  apb::ApprovalResponse *resp) {
+        const nebo_tool_handler_t *h = tools_[0].h;
+        resp->set_requires_approval(h->requires_approval ? h->requires_approval() : 0);
         return grpc::Status::OK;
     }
 
-    grpc::Status Configure(grpc::ServerContext *, const apb::SettingsMap *req,
-                           apb::Empty *) override {
+    grpc::Status ListTools(grpc::ServerContextBase *, const apb::ListToolsRequest *req,
+                           apb::ListToolsResponse *resp) {
+        const auto &known = req->known_fingerprints();
+        for (const ToolEntry &t : tools_) {
+            auto *info = resp->add_tools();
+            if (t.h->name)        info->set_name(t.h->name);
+            if (t.h->description) info->set_description(t.h->description);
+            info->set_schema_fingerprint(t.fingerprint);
+            if (t.h->schema && std::find(known.begin(), known.end(), t.fingerprint) == known.end())
+                info->set_schema(t.h->schema);
+            info->set_requires_approval(t.h->requires_approval ? t.h->requires_approval() : 0);
+        }
+        return grpc::Status::OK;
+    }
+
+    grpc::Status Configure(grpc::ServerContextBase *, const apb::SettingsMap *req,
+                           apb::Empty *) {
         configure_handler(*req, app_->on_configure);
         return grpc::Status::OK;
     }
@@ -134,14 +880,9 @@ public:
 
 /* ── ChannelBridge ───────────────────────────────────────────────────── */
 
-struct channel_stream_ctx {
-    grpc::ServerWriter<apb::InboundMessage> *writer;
-    grpc::ServerContext *ctx;
-};
-
 static int channel_push_trampoline(const nebo_inbound_message_t *msg, void *opaque) {
-    auto *sc = static_cast<channel_stream_ctx *>(opaque);
-    if (sc->ctx->IsCancelled()) return -1;
+    auto *sink = static_cast<StreamSink<apb::InboundMessage> *>(opaque);
+    if (sink->IsCancelled()) return -1;
     apb::InboundMessage im;
     if (msg->channel_id) im.set_channel_id(msg->channel_id);
     if (msg->user_id)    im.set_user_id(msg->user_id);
@@ -171,28 +912,28 @@ static int channel_push_trampoline(const nebo_inbound_message_t *msg, void *opaq
     if (msg->platform_data && msg->platform_data_len > 0)
         im.set_platform_data(msg->platform_data, msg->platform_data_len);
     if (msg->timestamp) im.set_timestamp(msg->timestamp);
-    return sc->writer->Write(im) ? 0 : -1;
+    return sink->Write(im) ? 0 : -1;
 }
 
-class ChannelBridge final : public apb::ChannelService::Service {
+class ChannelBridge final {
     const nebo_channel_handler_t *h_;
     const nebo_app_t *app_;
 public:
     ChannelBridge(const nebo_channel_handler_t *h, const nebo_app_t *app) : h_(h), app_(app) {}
 
-    grpc::Status HealthCheck(grpc::ServerContext *, const apb::HealthCheckRequest *,
-                             apb::HealthCheckResponse *resp) override {
+    grpc::Status HealthCheck(grpc::ServerContextBase *, const apb::HealthCheckRequest *,
+                             apb::HealthCheckResponse *resp) {
         return health_ok(resp, app_);
     }
 
-    grpc::Status ID(grpc::ServerContext *, const apb::Empty *,
-                    apb::IDResponse *resp) override {
+    grpc::Status ID(grpc::ServerContextBase *, const apb::Empty *,
+                    apb::IDResponse *resp) {
         if (h_->id) resp->set_id(h_->id);
         return grpc::Status::OK;
     }
 
-    grpc::Status Connect(grpc::ServerContext *, const apb::ChannelConnectRequest *req,
-                         apb::ChannelConnectResponse *resp) override {
+    grpc::Status Connect(grpc::ServerContextBase *, const apb::ChannelConnectRequest *req,
+                         apb::ChannelConnectResponse *resp) {
         if (!h_->connect) return grpc::Status::OK;
 
         const char **keys = nullptr, **vals = nullptr;
@@ -204,8 +945,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Disconnect(grpc::ServerContext *, const apb::Empty *,
-                            apb::ChannelDisconnectResponse *resp) override {
+    grpc::Status Disconnect(grpc::ServerContextBase *, const apb::Empty *,
+                            apb::ChannelDisconnectResponse *resp) {
         if (h_->disconnect) {
             int ret = h_->disconnect();
             if (ret != 0) resp->set_error("disconnect failed");
@@ -213,8 +954,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Send(grpc::ServerContext *, const apb::ChannelSendRequest *req,
-                      apb::ChannelSendResponse *resp) override {
+    grpc::Status Send(grpc::ServerContextBase *, const apb::ChannelSendRequest *req,
+                      apb::ChannelSendResponse *resp) {
         if (!h_->send) return grpc::Status::OK;
 
         /* Map proto sender */
@@ -273,16 +1014,15 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Receive(grpc::ServerContext *ctx, const apb::Empty *,
-                         grpc::ServerWriter<apb::InboundMessage> *writer) override {
+    grpc::Status Receive(grpc::ServerContextBase *, const apb::Empty *,
+                         StreamSink<apb::InboundMessage> *sink) {
         if (!h_->receive) return grpc::Status(grpc::UNIMPLEMENTED, "no receive handler");
-        channel_stream_ctx sc{writer, ctx};
-        int ret = h_->receive(channel_push_trampoline, &sc);
+        int ret = h_->receive(channel_push_trampoline, sink);
         return ret == 0 ? grpc::Status::OK : grpc::Status(grpc::INTERNAL, "receive error");
     }
 
-    grpc::Status Configure(grpc::ServerContext *, const apb::SettingsMap *req,
-                           apb::Empty *) override {
+    grpc::Status Configure(grpc::ServerContextBase *, const apb::SettingsMap *req,
+                           apb::Empty *) {
         configure_handler(*req, app_->on_configure);
         return grpc::Status::OK;
     }
@@ -290,102 +1030,220 @@ public:
 
 /* ── GatewayBridge ───────────────────────────────────────────────────── */
 
-struct gateway_stream_ctx {
-    grpc::ServerWriter<apb::GatewayEvent> *writer;
-    grpc::ServerContext *ctx;
-};
-
 static int gateway_push_trampoline(const nebo_gateway_event_t *evt, void *opaque) {
-    auto *sc = static_cast<gateway_stream_ctx *>(opaque);
-    if (sc->ctx->IsCancelled()) return -1;
+    auto *sink = static_cast<StreamSink<apb::GatewayEvent> *>(opaque);
+    if (sink->IsCancelled()) return -1;
     apb::GatewayEvent ge;
-    if (evt->type)       ge.set_type(evt->type);
-    if (evt->content)    ge.set_content(evt->content);
-    if (evt->model)      ge.set_model(evt->model);
-    if (evt->request_id) ge.set_request_id(evt->request_id);
-    return sc->writer->Write(ge) ? 0 : -1;
+    nebo_gateway_event_to_proto(evt, &ge);
+    return sink->Write(ge) ? 0 : -1;
 }
 
-class GatewayBridge final : public apb::GatewayService::Service {
+/** A gateway stream that fails as soon as the SDK cancels its call. */
+class CancellableGatewaySink final : public StreamSink<apb::GatewayEvent> {
+    StreamSink<apb::GatewayEvent> *sink_;
+    nebo_call *call_;
+public:
+    CancellableGatewaySink(StreamSink<apb::GatewayEvent> *sink, nebo_call *call)
+        : sink_(sink), call_(call) {}
+    bool IsCancelled() override { return call_->cancel_requested.load() || sink_->IsCancelled(); }
+    bool Write(const apb::GatewayEvent &ev) override {
+        return !call_->cancel_requested.load() && sink_->Write(ev);
+    }
+};
+
+/** A gateway stream as seen through its write queue. */
+class QueuedGatewaySink final : public StreamSink<apb::GatewayEvent> {
+    StreamSink<apb::GatewayEvent> *sink_;
+    GatewayWriter *writer_;
+public:
+    QueuedGatewaySink(StreamSink<apb::GatewayEvent> *sink, GatewayWriter *writer)
+        : sink_(sink), writer_(writer) {}
+    bool IsCancelled() override { return sink_->IsCancelled() || writer_->Failed(); }
+    bool Write(const apb::GatewayEvent &ev) override { return writer_->Push(ev); }
+};
+
+/** A proto GatewayRequest as the C handler sees it; strings borrow from the proto. */
+class GatewayRequestView {
+    std::vector<nebo_gateway_message_t> msgs_;
+    std::vector<nebo_gateway_tool_def_t> tools_;
+    nebo_user_context_t user_{};
+public:
+    nebo_gateway_request_t req{};
+
+    explicit GatewayRequestView(const apb::GatewayRequest &r)
+        : msgs_(r.messages_size()), tools_(r.tools_size()) {
+        for (int i = 0; i < r.messages_size(); i++) {
+            auto &m = r.messages(i);
+            msgs_[i].role = m.role().c_str();
+            msgs_[i].content = m.content().c_str();
+            msgs_[i].tool_call_id = m.tool_call_id().c_str();
+            msgs_[i].tool_calls = m.tool_calls().c_str();
+        }
+        for (int i = 0; i < r.tools_size(); i++) {
+            auto &t = r.tools(i);
+            tools_[i].name = t.name().c_str();
+            tools_[i].description = t.description().c_str();
+            tools_[i].input_schema = t.input_schema().c_str();
+            tools_[i].input_schema_len = (int)t.input_schema().size();
+        }
+        if (r.has_user()) {
+            user_.token = r.user().token().c_str();
+            user_.user_id = r.user().user_id().c_str();
+            user_.plan = r.user().plan().c_str();
+            req.user = &user_;
+        }
+        req.request_id = r.request_id().c_str();
+        req.messages = msgs_.data();
+        req.message_count = (int)msgs_.size();
+        req.tools = tools_.data();
+        req.tool_count = (int)tools_.size();
+        req.max_tokens = r.max_tokens();
+        req.temperature = r.temperature();
+        req.system = r.system().c_str();
+    }
+    GatewayRequestView(const GatewayRequestView &) = delete;
+    GatewayRequestView &operator=(const GatewayRequestView &) = delete;
+};
+
+/* Write queue of a coalescing stream whose handler did not set write_queue. */
+static const size_t kCoalesceQueue = 64;
+
+/* Longest a Poll waits for a first event; the call's deadline may cut it shorter. */
+static const std::chrono::milliseconds kPollWait(1000);
+
+class GatewayBridge final {
     const nebo_gateway_handler_t *h_;
     const nebo_app_t *app_;
+    GatewayPoller poller_;
+    std::unique_ptr<GatewayCoalescer> coalescer_;
+
+    /* Streamed calls in progress by request_id, for Cancel. */
+    std::mutex streams_mu_;
+    std::multimap<std::string, nebo_call *> streams_;
+
+    /** Keeps a call findable by its request_id while the handler runs. */
+    class Tracked {
+        GatewayBridge *b_;
+        std::multimap<std::string, nebo_call *>::iterator it_;
+    public:
+        Tracked(GatewayBridge *b, const std::string &request_id, nebo_call *call) : b_(b) {
+            std::lock_guard<std::mutex> lk(b_->streams_mu_);
+            it_ = b_->streams_.emplace(request_id, call);
+        }
+        ~Tracked() {
+            std::lock_guard<std::mutex> lk(b_->streams_mu_);
+            b_->streams_.erase(it_);
+        }
+        Tracked(const Tracked &) = delete;
+        Tracked &operator=(const Tracked &) = delete;
+    };
 public:
-    GatewayBridge(const nebo_gateway_handler_t *h, const nebo_app_t *app) : h_(h), app_(app) {}
+    GatewayBridge(const nebo_gateway_handler_t *h, const nebo_app_t *app)
+        : h_(h), app_(app),
+          poller_(h->poll_capacity > 0 ? (size_t)h->poll_capacity : 1024,
+                  std::chrono::milliseconds(h->poll_ttl_ms > 0 ? h->poll_ttl_ms : 30000)) {
+        if (h->coalesce_bytes > 0)
+            coalescer_.reset(new GatewayCoalescer(
+                (size_t)h->coalesce_bytes,
+                std::chrono::milliseconds(h->coalesce_ms > 0 ? h->coalesce_ms : 20)));
+    }
 
-    grpc::Status HealthCheck(grpc::ServerContext *, const apb::HealthCheckRequest *,
-                             apb::HealthCheckResponse *resp) override {
+    grpc::Status HealthCheck(grpc::ServerContextBase *, const apb::HealthCheckRequest *,
+                             apb::HealthCheckResponse *resp) {
         return health_ok(resp, app_);
     }
 
-    grpc::Status Stream(grpc::ServerContext *ctx, const apb::GatewayRequest *req,
-                        grpc::ServerWriter<apb::GatewayEvent> *writer) override {
+    grpc::Status Stream(grpc::ServerContextBase *, const apb::GatewayRequest *req,
+                        StreamSink<apb::GatewayEvent> *sink) {
         if (!h_->stream) return grpc::Status(grpc::UNIMPLEMENTED, "no stream handler");
 
-        /* Convert proto messages to C structs */
-        int msg_count = req->messages_size();
-        auto *msgs = new nebo_gateway_message_t[msg_count]();
-        for (int i = 0; i < msg_count; i++) {
-            auto &m = req->messages(i);
-            msgs[i].role = m.role().c_str();
-            msgs[i].content = m.content().c_str();
-            msgs[i].tool_call_id = m.tool_call_id().c_str();
-            msgs[i].tool_calls = m.tool_calls().c_str();
-        }
-
-        int tool_count = req->tools_size();
-        auto *tools = new nebo_gateway_tool_def_t[tool_count]();
-        for (int i = 0; i < tool_count; i++) {
-            auto &t = req->tools(i);
-            tools[i].name = t.name().c_str();
-            tools[i].description = t.description().c_str();
-            tools[i].input_schema = t.input_schema().c_str();
-            tools[i].input_schema_len = (int)t.input_schema().size();
-        }
-
-        nebo_user_context_t user_ctx{};
-        const nebo_user_context_t *user_ptr = nullptr;
-        if (req->has_user()) {
-            user_ctx.token = req->user().token().c_str();
-            user_ctx.user_id = req->user().user_id().c_str();
-            user_ctx.plan = req->user().plan().c_str();
-            user_ptr = &user_ctx;
-        }
-
-        nebo_gateway_request_t creq{};
-        creq.request_id = req->request_id().c_str();
-        creq.messages = msgs;
-        creq.message_count = msg_count;
-        creq.tools = tools;
-        creq.tool_count = tool_count;
-        creq.max_tokens = req->max_tokens();
-        creq.temperature = req->temperature();
-        creq.system = req->system().c_str();
-        creq.user = user_ptr;
-
-        gateway_stream_ctx sc{writer, ctx};
-        int ret = h_->stream(&creq, gateway_push_trampoline, &sc);
-
-        delete[] msgs;
-        delete[] tools;
+        if (req->poll()) {
+            /* The handler outlives this call, so it gets its own copy of the request. */
+            auto owned = std::make_shared<apb::GatewayRequest>(*req);
+            auto h = h_;
+            auto run = [owned, h](nebo_push_gateway_event_fn push, void *ctx) {
+                GatewayRequestView creq(*owned);
+                return h->stream(&creq.req, push, ctx);
+            };
+            bool started = poller_.Start(req->request_id(), run);
+            return started ? grpc::Status::OK
+                           : grpc::Status(grpc::ALREADY_EXISTS, "request_id is already being polled");
+        }
+
+        /* Cancel fails push() from here on and wakes nebo_call_on_cancel(). */
+        nebo_call *call = nebo_call_current();
+        Tracked tracked(this, req->request_id(), call);
+        CancellableGatewaySink cancellable(sink, call);
+        sink = &cancellable;
+
+        /* Coalescing always queues: its timer hands batches to the writer. */
+        std::unique_ptr<GatewayWriter> writer;
+        if (h_->write_queue > 0 || coalescer_) {
+            size_t capacity = h_->write_queue > 0 ? (size_t)h_->write_queue : kCoalesceQueue;
+            writer.reset(new GatewayWriter(h_, req->request_id(), capacity,
+                                           [sink](const apb::GatewayEvent &ge) {
+                return !sink->IsCancelled() && sink->Write(ge);
+            }));
+        }
+        QueuedGatewaySink queued(sink, writer.get());
+        StreamSink<apb::GatewayEvent> *out = writer ? &queued : sink;
+
+        GatewayRequestView creq(*req);
+        int ret;
+        if (coalescer_) {
+            GatewayWriter *w = writer.get();
+            auto cs = coalescer_->Open(
+                [out](const apb::GatewayEvent &ge) { return !out->IsCancelled() && out->Write(ge); },
+                [w](const apb::GatewayEvent &ge) { return w->Offer(ge); },
+                [call] { return call->cancel_requested.load(); });
+            ret = h_->stream(&creq.req, GatewayCoalescer::Push, cs.get());
+            GatewayCoalescer::Close(cs.get());
+        } else {
+            ret = h_->stream(&creq.req, gateway_push_trampoline, out);
+        }
+        if (writer) writer->Close();
         return ret == 0 ? grpc::Status::OK : grpc::Status(grpc::INTERNAL, "stream error");
     }
 
-    grpc::Status Poll(grpc::ServerContext *, const apb::PollRequest *,
-                      apb::PollResponse *) override {
-        return grpc::Status(grpc::UNIMPLEMENTED, "poll not supported in C SDK");
+    /* kPollWait, or what is left of the call's deadline if that is less. */
+    static std::chrono::milliseconds PollWait(grpc::ServerContextBase *ctx) {
+        auto wait = kPollWait;
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            ctx->deadline() - std::chrono::system_clock::now());
+        if (left < wait) wait = std::max(left, std::chrono::milliseconds(0));
+        return wait;
+    }
+
+    grpc::Status Poll(grpc::ServerContextBase *ctx, const apb::PollRequest *req,
+                      apb::PollResponse *resp) {
+        return poller_.Poll(req->request_id(), PollWait(ctx), resp);
     }
 
-    grpc::Status Cancel(grpc::ServerContext *, const apb::CancelRequest *req,
-                        apb::CancelResponse *resp) override {
-        if (h_->cancel) {
-            int ret = h_->cancel(req->request_id().c_str());
-            resp->set_cancelled(ret == 0);
+    /* Poll for the callback engine: parks with the poller, holding no thread. */
+    void PollAsync(grpc::ServerContextBase *ctx, const apb::PollRequest *req,
+                   apb::PollResponse *resp, std::function<void(grpc::Status)> done) {
+        poller_.PollAsync(req->request_id(), PollWait(ctx), resp, std::move(done));
+    }
+
+    grpc::Status Cancel(grpc::ServerContextBase *, const apb::CancelRequest *req,
+                        apb::CancelResponse *resp) {
+        bool found = false;
+        {
+            std::lock_guard<std::mutex> lk(streams_mu_);
+            auto range = streams_.equal_range(req->request_id());
+            for (auto it = range.first; it != range.second; ++it) {
+                it->second->Cancel();
+                found = true;
+            }
         }
+        found = poller_.Cancel(req->request_id()) || found;
+        if (h_->cancel && h_->cancel(req->request_id().c_str()) == 0) found = true;
+        resp->set_cancelled(found);
         return grpc::Status::OK;
     }
 
-    grpc::Status Configure(grpc::ServerContext *, const apb::SettingsMap *req,
-                           apb::Empty *) override {
+    grpc::Status Configure(grpc::ServerContextBase *, const apb::SettingsMap *req,
+                           apb::Empty *) {
         configure_handler(*req, app_->on_configure);
         return grpc::Status::OK;
     }
@@ -393,56 +1251,259 @@ public:
 
 /* ── UIBridge ────────────────────────────────────────────────────────── */
 
-class UIBridge final : public apb::UIService::Service {
-    const nebo_ui_handler_t *h_;
-    const nebo_app_t *app_;
-public:
-    UIBridge(const nebo_ui_handler_t *h, const nebo_app_t *app) : h_(h), app_(app) {}
+/* Largest body slice per HttpResponseChunk; bigger writes are split. */
+static const size_t kHttpChunk = 64 * 1024;
 
-    grpc::Status HealthCheck(grpc::ServerContext *, const apb::HealthCheckRequest *,
-                             apb::HealthCheckResponse *resp) override {
-        return health_ok(resp, app_);
+using HttpBidi = BidiStream<apb::HttpRequestChunk, apb::HttpResponseChunk>;
+
+/**
+ * A handler's side of one HTTP exchange. Streamed, it reads request chunks
+ * from io and writes response chunks to it. Buffered (io == nullptr), it
+ * reads a body already in memory and appends to the unary response.
+ */
+struct nebo_http_stream {
+    HttpBidi *io = nullptr;
+    apb::HttpResponse *buffered = nullptr;
+    const char *data = nullptr; /* request bytes not yet read: data[off, len) */
+    size_t len = 0;
+    size_t off = 0;
+    std::string chunk;          /* owns data while streaming */
+    bool eof = false;
+    bool head_sent = false;
+};
+
+static void fill_head(apb::HttpResponse *head, int status_code, const nebo_string_map_t *headers) {
+    head->set_status_code(status_code);
+    if (!headers) return;
+    auto *m = head->mutable_headers();
+    for (int i = 0; i < headers->count; i++) (*m)[headers->keys[i]] = headers->values[i];
+}
+
+extern "C" long nebo_http_stream_read(nebo_http_stream_t *s, void *buf, size_t cap) {
+    if (!s || (!buf && cap)) return -1;
+    while (s->off == s->len) {
+        if (s->eof || !s->io) return 0;
+        apb::HttpRequestChunk msg;
+        if (!s->io->Read(&msg)) {
+            if (s->io->IsCancelled()) return -1;
+            s->eof = true;
+            return 0;
+        }
+        s->chunk.swap(*msg.mutable_body());
+        s->data = s->chunk.data();
+        s->len = s->chunk.size();
+        s->off = 0;
     }
+    size_t n = std::min(cap, s->len - s->off);
+    memcpy(buf, s->data + s->off, n);
+    s->off += n;
+    return (long)n;
+}
 
-    grpc::Status HandleRequest(grpc::ServerContext *, const apb::HttpRequest *req,
-                               apb::HttpResponse *resp) override {
-        if (!h_->handle_request) return grpc::Status(grpc::UNIMPLEMENTED, "no handle_request handler");
+extern "C" int nebo_http_stream_write_head(nebo_http_stream_t *s, int status_code,
+                                           const nebo_string_map_t *headers) {
+    if (!s || s->head_sent) return -1;
+    s->head_sent = true;
+    if (s->buffered) {
+        fill_head(s->buffered, status_code, headers);
+        return 0;
+    }
+    apb::HttpResponseChunk msg;
+    fill_head(msg.mutable_head(), status_code, headers);
+    return s->io->Write(msg) ? 0 : -1;
+}
 
-        /* Map proto headers to C string map */
-        const char **hdr_keys = nullptr, **hdr_vals = nullptr;
-        nebo_string_map_t headers{};
-        if (req->headers_size() > 0) headers = proto_map_to_c(req->headers(), &hdr_keys, &hdr_vals);
+extern "C" int nebo_http_stream_write(nebo_http_stream_t *s, const void *data, size_t len) {
+    if (!s || (!data && len)) return -1;
+    if (!s->head_sent && nebo_http_stream_write_head(s, 200, nullptr) != 0) return -1;
+    const char *p = static_cast<const char *>(data);
+    if (s->buffered) {
+        s->buffered->mutable_body()->append(p, len);
+        return 0;
+    }
+    while (len > 0) {
+        size_t n = std::min(len, kHttpChunk);
+        apb::HttpResponseChunk msg;
+        msg.set_body(p, n);
+        if (!s->io->Write(msg)) return -1;
+        p += n;
+        len -= n;
+    }
+    return 0;
+}
 
-        nebo_http_request_t creq{};
-        creq.method   = req->method().c_str();
-        creq.path     = req->path().c_str();
-        creq.query    = req->query().c_str();
-        creq.headers  = req->headers_size() > 0 ? &headers : nullptr;
-        creq.body     = req->body().data();
-        creq.body_len = (int)req->body().size();
+extern "C" int nebo_http_stream_write_event(nebo_http_stream_t *s, const char *event,
+                                            const char *data) {
+    if (!s) return -1;
+    if (!s->head_sent) {
+        static const char *keys[] = {"Content-Type", "Cache-Control"};
+        static const char *values[] = {"text/event-stream", "no-cache"};
+        nebo_string_map_t headers{keys, values, 2};
+        if (nebo_http_stream_write_head(s, 200, &headers) != 0) return -1;
+    }
+    std::string ev;
+    if (event) {
+        ev += "event: ";
+        ev += event;
+        ev += '\n';
+    }
+    const char *line = data ? data : "";
+    for (;;) {
+        const char *nl = strchr(line, '\n');
+        ev += "data: ";
+        ev.append(line, nl ? (size_t)(nl - line) : strlen(line));
+        ev += '\n';
+        if (!nl) break;
+        line = nl + 1;
+    }
+    ev += '\n';
+    return nebo_http_stream_write(s, ev.data(), ev.size());
+}
 
-        nebo_http_response_t cresp{};
-        int ret = h_->handle_request(&creq, &cresp);
+/** A proto HttpRequest as the C handler sees it; strings borrow from the proto. */
+class HttpRequestView {
+    const char **keys_ = nullptr;
+    const char **vals_ = nullptr;
+    nebo_string_map_t headers_{};
+public:
+    nebo_http_request_t req{};
+
+    explicit HttpRequestView(const apb::HttpRequest &r) {
+        req.method = r.method().c_str();
+        req.path   = r.path().c_str();
+        req.query  = r.query().c_str();
+        if (r.headers_size() > 0) {
+            headers_ = proto_map_to_c(r.headers(), &keys_, &vals_);
+            req.headers = &headers_;
+        }
+    }
+    ~HttpRequestView() {
+        delete[] keys_;
+        delete[] vals_;
+    }
+    HttpRequestView(const HttpRequestView &) = delete;
+    HttpRequestView &operator=(const HttpRequestView &) = delete;
+};
 
-        delete[] hdr_keys;
-        delete[] hdr_vals;
+/** Sends a whole response as a head with the first body slice, then the rest. */
+static void write_chunked(HttpBidi *io, apb::HttpResponse *resp) {
+    std::string out = std::move(*resp->mutable_body());
+    apb::HttpResponseChunk chunk;
+    chunk.mutable_head()->Swap(resp);
+    size_t off = 0;
+    do {
+        size_t n = std::min(out.size() - off, kHttpChunk);
+        chunk.set_body(out.data() + off, n);
+        if (!io->Write(chunk)) break;
+        chunk.clear_head();
+        off += n;
+    } while (off < out.size());
+}
 
-        if (ret != 0) return grpc::Status(grpc::INTERNAL, "handle_request failed");
+/* Stands in for the handler of an app that only serves static files. */
+static const nebo_ui_handler_t kStaticOnly = {};
 
-        resp->set_status_code(cresp.status_code);
-        if (cresp.body && cresp.body_len > 0)
-            resp->set_body(cresp.body, cresp.body_len);
-        if (cresp.headers) {
-            auto *m = resp->mutable_headers();
-            for (int i = 0; i < cresp.headers->count; i++) {
-                (*m)[cresp.headers->keys[i]] = cresp.headers->values[i];
-            }
+class UIBridge final {
+    const nebo_ui_handler_t *h_;
+    const nebo_app_t *app_;
+    std::unique_ptr<StaticAssets> assets_;
+    std::unique_ptr<HttpCache> cache_; /* set when h->cache */
+
+    /** Serves a request whose body is in memory into resp, with either handler. */
+    grpc::Status Serve(const apb::HttpRequest &req, const std::string &body,
+                       apb::HttpResponse *resp) {
+        if (!h_->handle_request && !h_->handle_stream) {
+            resp->set_status_code(404);
+            return grpc::Status::OK;
         }
-        return grpc::Status::OK;
+        HttpRequestView creq(req);
+        if (!h_->handle_request) {
+            nebo_http_stream s;
+            s.buffered = resp;
+            s.data = body.data();
+            s.len = body.size();
+            if (h_->handle_stream(&creq.req, &s) != 0)
+                return grpc::Status(grpc::INTERNAL, "handle_stream failed");
+            if (!s.head_sent) resp->set_status_code(200);
+            return grpc::Status::OK;
+        }
+
+        auto run = [this, &creq, &body](apb::HttpResponse *out) {
+            creq.req.body     = body.data();
+            creq.req.body_len = (int)body.size();
+            nebo_http_response_t cresp{};
+            if (h_->handle_request(&creq.req, &cresp) != 0)
+                return grpc::Status(grpc::INTERNAL, "handle_request failed");
+
+            fill_head(out, cresp.status_code, cresp.headers);
+            if (cresp.body && cresp.body_len > 0)
+                out->set_body(cresp.body, cresp.body_len);
+            return grpc::Status::OK;
+        };
+        return cache_ ? cache_->Serve(req, resp, run) : run(resp);
+    }
+
+public:
+    UIBridge(const nebo_ui_handler_t *h, const nebo_app_t *app) : h_(h), app_(app) {
+        if (h->cache && h->handle_request) cache_.reset(new HttpCache(h));
+        if (app->static_prefix) {
+            std::string root = app->dir;
+            if (app->static_dir[0]) root = (root.empty() ? "" : root + "/") + app->static_dir;
+            assets_.reset(new StaticAssets(root.empty() ? "." : root, app->static_prefix));
+        }
+    }
+
+    grpc::Status HealthCheck(grpc::ServerContextBase *, const apb::HealthCheckRequest *,
+                             apb::HealthCheckResponse *resp) {
+        return health_ok(resp, app_);
+    }
+
+    grpc::Status HandleRequest(grpc::ServerContextBase *, const apb::HttpRequest *req,
+                               apb::HttpResponse *resp) {
+        if (!assets_ && !h_->handle_request && !h_->handle_stream)
+            return grpc::Status(grpc::UNIMPLEMENTED, "no handle_request handler");
+        if (assets_ && assets_->Serve(*req, resp)) return grpc::Status::OK;
+        return Serve(*req, req->body(), resp);
     }
 
-    grpc::Status Configure(grpc::ServerContext *, const apb::SettingsMap *req,
-                           apb::Empty *) override {
+    grpc::Status HandleRequestStream(grpc::ServerContextBase *, HttpBidi *io) {
+        if (!assets_ && !h_->handle_request && !h_->handle_stream)
+            return grpc::Status(grpc::UNIMPLEMENTED, "no handle_request handler");
+        apb::HttpRequestChunk first;
+        if (!io->Read(&first)) return grpc::Status(grpc::INVALID_ARGUMENT, "missing request head");
+        apb::HttpRequest *head = first.mutable_head();
+        apb::HttpResponse resp;
+        if (assets_ && assets_->Serve(*head, &resp)) {
+            write_chunked(io, &resp);
+            return grpc::Status::OK;
+        }
+        std::string body = std::move(*head->mutable_body());
+        body.append(first.body());
+
+        if (h_->handle_stream) {
+            HttpRequestView creq(*head);
+            nebo_http_stream s;
+            s.io = io;
+            s.chunk.swap(body);
+            s.data = s.chunk.data();
+            s.len = s.chunk.size();
+            if (h_->handle_stream(&creq.req, &s) != 0)
+                return grpc::Status(grpc::INTERNAL, "handle_stream failed");
+            if (!s.head_sent) nebo_http_stream_write_head(&s, 200, nullptr);
+            return grpc::Status::OK;
+        }
+
+        /* handle_request only: buffer the body, then stream the response. */
+        apb::HttpRequestChunk msg;
+        while (io->Read(&msg)) body.append(msg.body());
+        if (io->IsCancelled()) return grpc::Status(grpc::CANCELLED, "request cancelled");
+        grpc::Status st = Serve(*head, body, &resp);
+        if (st.ok()) write_chunked(io, &resp);
+        return st;
+    }
+
+    grpc::Status Configure(grpc::ServerContextBase *, const apb::SettingsMap *req,
+                           apb::Empty *) {
         configure_handler(*req, app_->on_configure);
         return grpc::Status::OK;
     }
@@ -450,14 +1511,9 @@ public:
 
 /* ── CommBridge ──────────────────────────────────────────────────────── */
 
-struct comm_stream_ctx {
-    grpc::ServerWriter<apb::CommMessage> *writer;
-    grpc::ServerContext *ctx;
-};
-
 static int comm_push_trampoline(const nebo_comm_message_t *msg, void *opaque) {
-    auto *sc = static_cast<comm_stream_ctx *>(opaque);
-    if (sc->ctx->IsCancelled()) return -1;
+    auto *sink = static_cast<StreamSink<apb::CommMessage> *>(opaque);
+    if (sink->IsCancelled()) return -1;
     apb::CommMessage cm;
     if (msg->id)              cm.set_id(msg->id);
     if (msg->from)            cm.set_from(msg->from);
@@ -469,34 +1525,34 @@ static int comm_push_trampoline(const nebo_comm_message_t *msg, void *opaque) {
     cm.set_timestamp(msg->timestamp);
     cm.set_human_injected(msg->human_injected);
     if (msg->human_id)        cm.set_human_id(msg->human_id);
-    return sc->writer->Write(cm) ? 0 : -1;
+    return sink->Write(cm) ? 0 : -1;
 }
 
-class CommBridge final : public apb::CommService::Service {
+class CommBridge final {
     const nebo_comm_handler_t *h_;
     const nebo_app_t *app_;
 public:
     CommBridge(const nebo_comm_handler_t *h, const nebo_app_t *app) : h_(h), app_(app) {}
 
-    grpc::Status HealthCheck(grpc::ServerContext *, const apb::HealthCheckRequest *,
-                             apb::HealthCheckResponse *resp) override {
+    grpc::Status HealthCheck(grpc::ServerContextBase *, const apb::HealthCheckRequest *,
+                             apb::HealthCheckResponse *resp) {
         return health_ok(resp, app_);
     }
 
-    grpc::Status Name(grpc::ServerContext *, const apb::Empty *,
-                      apb::CommNameResponse *resp) override {
+    grpc::Status Name(grpc::ServerContextBase *, const apb::Empty *,
+                      apb::CommNameResponse *resp) {
         if (h_->name) resp->set_name(h_->name());
         return grpc::Status::OK;
     }
 
-    grpc::Status Version(grpc::ServerContext *, const apb::Empty *,
-                         apb::CommVersionResponse *resp) override {
+    grpc::Status Version(grpc::ServerContextBase *, const apb::Empty *,
+                         apb::CommVersionResponse *resp) {
         if (h_->version) resp->set_version(h_->version());
         return grpc::Status::OK;
     }
 
-    grpc::Status Connect(grpc::ServerContext *, const apb::CommConnectRequest *req,
-                         apb::CommConnectResponse *resp) override {
+    grpc::Status Connect(grpc::ServerContextBase *, const apb::CommConnectRequest *req,
+                         apb::CommConnectResponse *resp) {
         if (!h_->connect) return grpc::Status::OK;
         const char **keys = nullptr, **vals = nullptr;
         nebo_string_map_t map = proto_map_to_c(req->config(), &keys, &vals);
@@ -508,8 +1564,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Disconnect(grpc::ServerContext *, const apb::Empty *,
-                            apb::CommDisconnectResponse *resp) override {
+    grpc::Status Disconnect(grpc::ServerContextBase *, const apb::Empty *,
+                            apb::CommDisconnectResponse *resp) {
         if (!h_->disconnect) return grpc::Status::OK;
         char *err = nullptr;
         int ret = h_->disconnect(&err);
@@ -517,14 +1573,14 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status IsConnected(grpc::ServerContext *, const apb::Empty *,
-                             apb::CommIsConnectedResponse *resp) override {
+    grpc::Status IsConnected(grpc::ServerContextBase *, const apb::Empty *,
+                             apb::CommIsConnectedResponse *resp) {
         if (h_->is_connected) resp->set_connected(h_->is_connected());
         return grpc::Status::OK;
     }
 
-    grpc::Status Send(grpc::ServerContext *, const apb::CommSendRequest *req,
-                      apb::CommSendResponse *resp) override {
+    grpc::Status Send(grpc::ServerContextBase *, const apb::CommSendRequest *req,
+                      apb::CommSendResponse *resp) {
         if (!h_->send) return grpc::Status::OK;
         auto &pm = req->message();
 
@@ -546,8 +1602,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Subscribe(grpc::ServerContext *, const apb::CommSubscribeRequest *req,
-                           apb::CommSubscribeResponse *resp) override {
+    grpc::Status Subscribe(grpc::ServerContextBase *, const apb::CommSubscribeRequest *req,
+                           apb::CommSubscribeResponse *resp) {
         if (!h_->subscribe) return grpc::Status::OK;
         char *err = nullptr;
         int ret = h_->subscribe(req->topic().c_str(), &err);
@@ -555,8 +1611,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Unsubscribe(grpc::ServerContext *, const apb::CommUnsubscribeRequest *req,
-                             apb::CommUnsubscribeResponse *resp) override {
+    grpc::Status Unsubscribe(grpc::ServerContextBase *, const apb::CommUnsubscribeRequest *req,
+                             apb::CommUnsubscribeResponse *resp) {
         if (!h_->unsubscribe) return grpc::Status::OK;
         char *err = nullptr;
         int ret = h_->unsubscribe(req->topic().c_str(), &err);
@@ -564,8 +1620,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Register(grpc::ServerContext *, const apb::CommRegisterRequest *req,
-                          apb::CommRegisterResponse *resp) override {
+    grpc::Status Register(grpc::ServerContextBase *, const apb::CommRegisterRequest *req,
+                          apb::CommRegisterResponse *resp) {
         if (!h_->reg) return grpc::Status::OK;
         int cap_count = req->capabilities_size();
         auto **caps = new const char *[cap_count];
@@ -577,8 +1633,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Deregister(grpc::ServerContext *, const apb::Empty *,
-                            apb::CommDeregisterResponse *resp) override {
+    grpc::Status Deregister(grpc::ServerContextBase *, const apb::Empty *,
+                            apb::CommDeregisterResponse *resp) {
         if (!h_->dereg) return grpc::Status::OK;
         char *err = nullptr;
         int ret = h_->dereg(&err);
@@ -586,16 +1642,15 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Receive(grpc::ServerContext *ctx, const apb::Empty *,
-                         grpc::ServerWriter<apb::CommMessage> *writer) override {
+    grpc::Status Receive(grpc::ServerContextBase *, const apb::Empty *,
+                         StreamSink<apb::CommMessage> *sink) {
         if (!h_->receive) return grpc::Status(grpc::UNIMPLEMENTED, "no receive handler");
-        comm_stream_ctx sc{writer, ctx};
-        int ret = h_->receive(comm_push_trampoline, &sc);
+        int ret = h_->receive(comm_push_trampoline, sink);
         return ret == 0 ? grpc::Status::OK : grpc::Status(grpc::INTERNAL, "receive error");
     }
 
-    grpc::Status Configure(grpc::ServerContext *, const apb::SettingsMap *req,
-                           apb::Empty *) override {
+    grpc::Status Configure(grpc::ServerContextBase *, const apb::SettingsMap *req,
+                           apb::Empty *) {
         configure_handler(*req, app_->on_configure);
         return grpc::Status::OK;
     }
@@ -625,14 +1680,9 @@ static void schedule_c_to_proto(const nebo_schedule_t *cs, apb::Schedule *ps) {
     }
 }
 
-struct schedule_stream_ctx {
-    grpc::ServerWriter<apb::ScheduleTrigger> *writer;
-    grpc::ServerContext *ctx;
-};
-
 static int schedule_push_trampoline(const nebo_schedule_trigger_t *trigger, void *opaque) {
-    auto *sc = static_cast<schedule_stream_ctx *>(opaque);
-    if (sc->ctx->IsCancelled()) return -1;
+    auto *sink = static_cast<StreamSink<apb::ScheduleTrigger> *>(opaque);
+    if (sink->IsCancelled()) return -1;
     apb::ScheduleTrigger st;
     if (trigger->schedule_id) st.set_schedule_id(trigger->schedule_id);
     if (trigger->name)        st.set_name(trigger->name);
@@ -647,22 +1697,22 @@ static int schedule_push_trampoline(const nebo_schedule_trigger_t *trigger, void
             (*m)[trigger->metadata->keys[i]] = trigger->metadata->values[i];
         }
     }
-    return sc->writer->Write(st) ? 0 : -1;
+    return sink->Write(st) ? 0 : -1;
 }
 
-class ScheduleBridge final : public apb::ScheduleService::Service {
+class ScheduleBridge final {
     const nebo_schedule_handler_t *h_;
     const nebo_app_t *app_;
 public:
     ScheduleBridge(const nebo_schedule_handler_t *h, const nebo_app_t *app) : h_(h), app_(app) {}
 
-    grpc::Status HealthCheck(grpc::ServerContext *, const apb::HealthCheckRequest *,
-                             apb::HealthCheckResponse *resp) override {
+    grpc::Status HealthCheck(grpc::ServerContextBase *, const apb::HealthCheckRequest *,
+                             apb::HealthCheckResponse *resp) {
         return health_ok(resp, app_);
     }
 
-    grpc::Status Create(grpc::ServerContext *, const apb::CreateScheduleRequest *req,
-                        apb::ScheduleResponse *resp) override {
+    grpc::Status Create(grpc::ServerContextBase *, const apb::CreateScheduleRequest *req,
+                        apb::ScheduleResponse *resp) {
         if (!h_->create) return grpc::Status(grpc::UNIMPLEMENTED, "no create handler");
 
         const char **keys = nullptr, **vals = nullptr;
@@ -693,8 +1743,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Get(grpc::ServerContext *, const apb::GetScheduleRequest *req,
-                     apb::ScheduleResponse *resp) override {
+    grpc::Status Get(grpc::ServerContextBase *, const apb::GetScheduleRequest *req,
+                     apb::ScheduleResponse *resp) {
         if (!h_->get) return grpc::Status(grpc::UNIMPLEMENTED, "no get handler");
         nebo_schedule_t out{};
         char *err = nullptr;
@@ -707,8 +1757,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status List(grpc::ServerContext *, const apb::ListSchedulesRequest *req,
-                      apb::ListSchedulesResponse *resp) override {
+    grpc::Status List(grpc::ServerContextBase *, const apb::ListSchedulesRequest *req,
+                      apb::ListSchedulesResponse *resp) {
         if (!h_->list) return grpc::Status(grpc::UNIMPLEMENTED, "no list handler");
         nebo_schedule_t *schedules = nullptr;
         int count = 0;
@@ -728,8 +1778,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Update(grpc::ServerContext *, const apb::UpdateScheduleRequest *req,
-                        apb::ScheduleResponse *resp) override {
+    grpc::Status Update(grpc::ServerContextBase *, const apb::UpdateScheduleRequest *req,
+                        apb::ScheduleResponse *resp) {
         if (!h_->update) return grpc::Status(grpc::UNIMPLEMENTED, "no update handler");
 
         const char **keys = nullptr, **vals = nullptr;
@@ -760,8 +1810,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Delete(grpc::ServerContext *, const apb::DeleteScheduleRequest *req,
-                        apb::DeleteScheduleResponse *resp) override {
+    grpc::Status Delete(grpc::ServerContextBase *, const apb::DeleteScheduleRequest *req,
+                        apb::DeleteScheduleResponse *resp) {
         if (!h_->delete_schedule) return grpc::Status(grpc::UNIMPLEMENTED, "no delete handler");
         char *err = nullptr;
         int ret = h_->delete_schedule(req->name().c_str(), &err);
@@ -770,8 +1820,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Enable(grpc::ServerContext *, const apb::ScheduleNameRequest *req,
-                        apb::ScheduleResponse *resp) override {
+    grpc::Status Enable(grpc::ServerContextBase *, const apb::ScheduleNameRequest *req,
+                        apb::ScheduleResponse *resp) {
         if (!h_->enable) return grpc::Status(grpc::UNIMPLEMENTED, "no enable handler");
         nebo_schedule_t out{};
         char *err = nullptr;
@@ -784,8 +1834,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Disable(grpc::ServerContext *, const apb::ScheduleNameRequest *req,
-                         apb::ScheduleResponse *resp) override {
+    grpc::Status Disable(grpc::ServerContextBase *, const apb::ScheduleNameRequest *req,
+                         apb::ScheduleResponse *resp) {
         if (!h_->disable) return grpc::Status(grpc::UNIMPLEMENTED, "no disable handler");
         nebo_schedule_t out{};
         char *err = nullptr;
@@ -798,8 +1848,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Trigger(grpc::ServerContext *, const apb::ScheduleNameRequest *req,
-                         apb::TriggerResponse *resp) override {
+    grpc::Status Trigger(grpc::ServerContextBase *, const apb::ScheduleNameRequest *req,
+                         apb::TriggerResponse *resp) {
         if (!h_->trigger) return grpc::Status(grpc::UNIMPLEMENTED, "no trigger handler");
         int success = 0;
         char *output = nullptr;
@@ -811,8 +1861,8 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status History(grpc::ServerContext *, const apb::ScheduleHistoryRequest *req,
-                         apb::ScheduleHistoryResponse *resp) override {
+    grpc::Status History(grpc::ServerContextBase *, const apb::ScheduleHistoryRequest *req,
+                         apb::ScheduleHistoryResponse *resp) {
         if (!h_->history) return grpc::Status(grpc::UNIMPLEMENTED, "no history handler");
         nebo_schedule_history_entry_t *entries = nullptr;
         int count = 0;
@@ -839,27 +1889,502 @@ public:
         return grpc::Status::OK;
     }
 
-    grpc::Status Triggers(grpc::ServerContext *ctx, const apb::Empty *,
-                          grpc::ServerWriter<apb::ScheduleTrigger> *writer) override {
+    grpc::Status Triggers(grpc::ServerContextBase *, const apb::Empty *,
+                          StreamSink<apb::ScheduleTrigger> *sink) {
         if (!h_->triggers) return grpc::Status(grpc::UNIMPLEMENTED, "no triggers handler");
-        schedule_stream_ctx sc{writer, ctx};
-        int ret = h_->triggers(schedule_push_trampoline, &sc);
+        int ret = h_->triggers(schedule_push_trampoline, sink);
         return ret == 0 ? grpc::Status::OK : grpc::Status(grpc::INTERNAL, "triggers error");
     }
 
-    grpc::Status Configure(grpc::ServerContext *, const apb::SettingsMap *req,
-                           apb::Empty *) override {
+    grpc::Status Configure(grpc::ServerContextBase *, const apb::SettingsMap *req,
+                           apb::Empty *) {
         configure_handler(*req, app_->on_configure);
         return grpc::Status::OK;
     }
 };
 
+/* ── Sync engine ─────────────────────────────────────────────────────── */
+
+template <class Msg>
+class SyncSink final : public StreamSink<Msg> {
+    grpc::ServerContext *ctx_;
+    grpc::ServerWriter<Msg> *writer_;
+public:
+    SyncSink(grpc::ServerContext *ctx, grpc::ServerWriter<Msg> *writer) : ctx_(ctx), writer_(writer) {}
+    bool IsCancelled() override { return ctx_->IsCancelled(); }
+    bool Write(const Msg &msg) override { return writer_->Write(msg); }
+};
+
+template <class In, class Out>
+class SyncBidi final : public BidiStream<In, Out> {
+    grpc::ServerContext *ctx_;
+    grpc::ServerReaderWriter<Out, In> *stream_;
+public:
+    SyncBidi(grpc::ServerContext *ctx, grpc::ServerReaderWriter<Out, In> *stream)
+        : ctx_(ctx), stream_(stream) {}
+    bool IsCancelled() override { return ctx_->IsCancelled(); }
+    bool Read(In *msg) override { return stream_->Read(msg); }
+    bool Write(const Out &msg) override { return stream_->Write(msg); }
+};
+
+/* Both engines run every bridge method under a ScopedCall (see nebo/call.h). */
+#define SYNC_UNARY(M, Req, Resp)                                                       \
+    grpc::Status M(grpc::ServerContext *ctx, const Req *req, Resp *resp) override {    \
+        ScopedCall call(ctx);                                                          \
+        return b_->M(ctx, req, resp);                                                  \
+    }
+
+#define SYNC_STREAM(M, Req, Msg)                                                       \
+    grpc::Status M(grpc::ServerContext *ctx, const Req *req,                           \
+                   grpc::ServerWriter<Msg> *writer) override {                         \
+        SyncSink<Msg> sink(ctx, writer);                                               \
+        ScopedCall call(ctx);                                                          \
+        return b_->M(ctx, req, &sink);                                                 \
+    }
+
+#define SYNC_BIDI(M, In, Out)                                                          \
+    grpc::Status M(grpc::ServerContext *ctx,                                           \
+                   grpc::ServerReaderWriter<Out, In> *stream) override {               \
+        SyncBidi<In, Out> io(ctx, stream);                                             \
+        ScopedCall call(ctx);                                                          \
+        return b_->M(ctx, &io);                                                        \
+    }
+
+/*
+ * Raw methods take and return serialized bytes. They finish inline on the
+ * gRPC thread under either engine: the bridge only hands back a buffer.
+ */
+#define RAW_UNARY(M)                                                                   \
+    grpc::ServerUnaryReactor *M(grpc::CallbackServerContext *ctx,                      \
+                                const grpc::ByteBuffer *req,                           \
+                                grpc::ByteBuffer *resp) override {                     \
+        grpc::ServerUnaryReactor *reactor = ctx->DefaultReactor();                     \
+        reactor->Finish(b_->M(ctx, req, resp));                                        \
+        return reactor;                                                                \
+    }
+
+/* Name, Description and Schema are answered from pre-serialized responses. */
+template <class Base>
+using ToolRawMetadata = apb::ToolService::WithRawCallbackMethod_Name<
+    apb::ToolService::WithRawCallbackMethod_Description<
+        apb::ToolService::WithRawCallbackMethod_Schema<Base>>>;
+
+class ToolSyncService final : public ToolRawMetadata<apb::ToolService::Service> {
+    ToolBridge *b_;
+public:
+    explicit ToolSyncService(ToolBridge *b) : b_(b) {}
+    SYNC_UNARY(HealthCheck, apb::HealthCheckRequest, apb::HealthCheckResponse)
+    RAW_UNARY(Name)
+    RAW_UNARY(Description)
+    RAW_UNARY(Schema)
+    SYNC_UNARY(Execute, apb::ExecuteRequest, apb::ExecuteResponse)
+    SYNC_STREAM(ExecuteStream, apb::ExecuteRequest, apb::ExecuteChunk)
+    SYNC_UNARY(ExecuteBatch, apb::ExecuteBatchRequest, apb::ExecuteBatchResponse)
+    SYNC_STREAM(ExecuteBatchStream, apb::ExecuteBatchRequest, apb::ExecuteBatchResult)
+    SYNC_UNARY(RequiresApproval, apb::Empty, apb::ApprovalResponse)
+    SYNC_UNARY(Configure, apb::SettingsMap, apb::Empty)
+    SYNC_UNARY(ListTools, apb::ListToolsRequest, apb::ListToolsResponse)
+};
+
+class ChannelSyncService final : public apb::ChannelService::Service {
+    ChannelBridge *b_;
+public:
+    explicit ChannelSyncService(ChannelBridge *b) : b_(b) {}
+    SYNC_UNARY(HealthCheck, apb::HealthCheckRequest, apb::HealthCheckResponse)
+    SYNC_UNARY(ID, apb::Empty, apb::IDResponse)
+    SYNC_UNARY(Connect, apb::ChannelConnectRequest, apb::ChannelConnectResponse)
+    SYNC_UNARY(Disconnect, apb::Empty, apb::ChannelDisconnectResponse)
+    SYNC_UNARY(Send, apb::ChannelSendRequest, apb::ChannelSendResponse)
+    SYNC_STREAM(Receive, apb::Empty, apb::InboundMessage)
+    SYNC_UNARY(Configure, apb::SettingsMap, apb::Empty)
+};
+
+class GatewaySyncService final : public apb::GatewayService::Service {
+    GatewayBridge *b_;
+public:
+    explicit GatewaySyncService(GatewayBridge *b) : b_(b) {}
+    SYNC_UNARY(HealthCheck, apb::HealthCheckRequest, apb::HealthCheckResponse)
+    SYNC_STREAM(Stream, apb::GatewayRequest, apb::GatewayEvent)
+    SYNC_UNARY(Poll, apb::PollRequest, apb::PollResponse)
+    SYNC_UNARY(Cancel, apb::CancelRequest, apb::CancelResponse)
+    SYNC_UNARY(Configure, apb::SettingsMap, apb::Empty)
+};
+
+class UISyncService final : public apb::UIService::Service {
+    UIBridge *b_;
+public:
+    explicit UISyncService(UIBridge *b) : b_(b) {}
+    SYNC_UNARY(HealthCheck, apb::HealthCheckRequest, apb::HealthCheckResponse)
+    SYNC_UNARY(HandleRequest, apb::HttpRequest, apb::HttpResponse)
+    SYNC_BIDI(HandleRequestStream, apb::HttpRequestChunk, apb::HttpResponseChunk)
+    SYNC_UNARY(Configure, apb::SettingsMap, apb::Empty)
+};
+
+class CommSyncService final : public apb::CommService::Service {
+    CommBridge *b_;
+public:
+    explicit CommSyncService(CommBridge *b) : b_(b) {}
+    SYNC_UNARY(HealthCheck, apb::HealthCheckRequest, apb::HealthCheckResponse)
+    SYNC_UNARY(Name, apb::Empty, apb::CommNameResponse)
+    SYNC_UNARY(Version, apb::Empty, apb::CommVersionResponse)
+    SYNC_UNARY(Connect, apb::CommConnectRequest, apb::CommConnectResponse)
+    SYNC_UNARY(Disconnect, apb::Empty, apb::CommDisconnectResponse)
+    SYNC_UNARY(IsConnected, apb::Empty, apb::CommIsConnectedResponse)
+    SYNC_UNARY(Send, apb::CommSendRequest, apb::CommSendResponse)
+    SYNC_UNARY(Subscribe, apb::CommSubscribeRequest, apb::CommSubscribeResponse)
+    SYNC_UNARY(Unsubscribe, apb::CommUnsubscribeRequest, apb::CommUnsubscribeResponse)
+    SYNC_UNARY(Register, apb::CommRegisterRequest, apb::CommRegisterResponse)
+    SYNC_UNARY(Deregister, apb::Empty, apb::CommDeregisterResponse)
+    SYNC_STREAM(Receive, apb::Empty, apb::CommMessage)
+    SYNC_UNARY(Configure, apb::SettingsMap, apb::Empty)
+};
+
+class ScheduleSyncService final : public apb::ScheduleService::Service {
+    ScheduleBridge *b_;
+public:
+    explicit ScheduleSyncService(ScheduleBridge *b) : b_(b) {}
+    SYNC_UNARY(HealthCheck, apb::HealthCheckRequest, apb::HealthCheckResponse)
+    SYNC_UNARY(Create, apb::CreateScheduleRequest, apb::ScheduleResponse)
+    SYNC_UNARY(Get, apb::GetScheduleRequest, apb::ScheduleResponse)
+    SYNC_UNARY(List, apb::ListSchedulesRequest, apb::ListSchedulesResponse)
+    SYNC_UNARY(Update, apb::UpdateScheduleRequest, apb::ScheduleResponse)
+    SYNC_UNARY(Delete, apb::DeleteScheduleRequest, apb::DeleteScheduleResponse)
+    SYNC_UNARY(Enable, apb::ScheduleNameRequest, apb::ScheduleResponse)
+    SYNC_UNARY(Disable, apb::ScheduleNameRequest, apb::ScheduleResponse)
+    SYNC_UNARY(Trigger, apb::ScheduleNameRequest, apb::TriggerResponse)
+    SYNC_UNARY(History, apb::ScheduleHistoryRequest, apb::ScheduleHistoryResponse)
+    SYNC_STREAM(Triggers, apb::Empty, apb::ScheduleTrigger)
+    SYNC_UNARY(Configure, apb::SettingsMap, apb::Empty)
+};
+
+/* ── Callback engine ─────────────────────────────────────────────────── */
+
+/**
+ * Server-streaming reactor. The C handler blocks for the stream's lifetime,
+ * so it runs on a dedicated thread; push() starts an async write and waits
+ * for its completion, giving the handler the same backpressure as the sync
+ * ServerWriter without tying up a gRPC thread.
+ */
+template <class Msg>
+class StreamReactor final : public grpc::ServerWriteReactor<Msg>, public StreamSink<Msg> {
+    std::mutex write_mu_; /* serializes push() from multiple handler threads */
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool cancelled_ = false;
+    bool pending_ = false;
+    bool write_ok_ = false;
+public:
+    explicit StreamReactor(std::function<grpc::Status(StreamSink<Msg> *)> body) {
+        std::thread([this, body] {
+            grpc::Status status = body(this);
+            /* OnDone() deletes the reactor; nothing may touch it after Finish. */
+            this->Finish(status);
+        }).detach();
+    }
+
+    bool IsCancelled() override {
+        std::lock_guard<std::mutex> lock(mu_);
+        return cancelled_;
+    }
+
+    bool Write(const Msg &msg) override {
+        std::lock_guard<std::mutex> wlock(write_mu_);
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (cancelled_) return false;
+            pending_ = true;
+        }
+        this->StartWrite(&msg);
+        /* msg is owned by the caller, so wait for OnWriteDone even if cancelled. */
+        std::unique_lock<std::mutex> lock(mu_);
+        cv_.wait(lock, [this] { return !pending_; });
+        return write_ok_;
+    }
+
+    void OnWriteDone(bool ok) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        pending_ = false;
+        write_ok_ = ok;
+        cv_.notify_all();
+    }
+
+    void OnCancel() override {
+        std::lock_guard<std::mutex> lock(mu_);
+        cancelled_ = true;
+    }
+
+    void OnDone() override { delete this; }
+};
+
+/**
+ * Bidi counterpart of StreamReactor: the body runs on its own thread and
+ * Read/Write block until gRPC reports the operation done. One read and one
+ * write may be in flight at once.
+ */
+template <class In, class Out>
+class BidiReactor final : public grpc::ServerBidiReactor<In, Out>, public BidiStream<In, Out> {
+    std::mutex write_mu_;
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool cancelled_ = false;
+    bool reading_ = false;
+    bool read_ok_ = false;
+    bool writing_ = false;
+    bool write_ok_ = false;
+public:
+    explicit BidiReactor(std::function<grpc::Status(BidiStream<In, Out> *)> body) {
+        std::thread([this, body] {
+            grpc::Status status = body(this);
+            this->Finish(status);
+        }).detach();
+    }
+
+    bool IsCancelled() override {
+        std::lock_guard<std::mutex> lock(mu_);
+        return cancelled_;
+    }
+
+    bool Read(In *msg) override {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (cancelled_) return false;
+            reading_ = true;
+        }
+        this->StartRead(msg);
+        std::unique_lock<std::mutex> lock(mu_);
+        cv_.wait(lock, [this] { return !reading_; });
+        return read_ok_;
+    }
+
+    bool Write(const Out &msg) override {
+        std::lock_guard<std::mutex> wlock(write_mu_);
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (cancelled_) return false;
+            writing_ = true;
+        }
+        this->StartWrite(&msg);
+        std::unique_lock<std::mutex> lock(mu_);
+        cv_.wait(lock, [this] { return !writing_; });
+        return write_ok_;
+    }
+
+    void OnReadDone(bool ok) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        reading_ = false;
+        read_ok_ = ok;
+        cv_.notify_all();
+    }
+
+    void OnWriteDone(bool ok) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        writing_ = false;
+        write_ok_ = ok;
+        cv_.notify_all();
+    }
+
+    void OnCancel() override {
+        std::lock_guard<std::mutex> lock(mu_);
+        cancelled_ = true;
+    }
+
+    void OnDone() override { delete this; }
+};
+
+static grpc::ServerUnaryReactor *run_unary(WorkerPool *pool, grpc::CallbackServerContext *ctx,
+                                           std::function<grpc::Status()> fn) {
+    grpc::ServerUnaryReactor *reactor = ctx->DefaultReactor();
+    pool->Submit([reactor, ctx, fn] {
+        grpc::Status st;
+        {
+            ScopedCall call(ctx); /* ends before Finish frees ctx */
+            st = fn();
+        }
+        reactor->Finish(st);
+    });
+    return reactor;
+}
+
+/* HealthCheck answers inline so a saturated pool never fails liveness probes. */
+#define CALLBACK_HEALTH()                                                              \
+    grpc::ServerUnaryReactor *HealthCheck(grpc::CallbackServerContext *ctx,            \
+                                          const apb::HealthCheckRequest *req,          \
+                                          apb::HealthCheckResponse *resp) override {   \
+        grpc::ServerUnaryReactor *reactor = ctx->DefaultReactor();                     \
+        reactor->Finish(b_->HealthCheck(ctx, req, resp));                              \
+        return reactor;                                                                \
+    }
+
+#define CALLBACK_UNARY(M, Req, Resp)                                                   \
+    grpc::ServerUnaryReactor *M(grpc::CallbackServerContext *ctx, const Req *req,      \
+                                Resp *resp) override {                                 \
+        return run_unary(pool_, ctx, [this, ctx, req, resp] {                          \
+            return b_->M(ctx, req, resp);                                              \
+        });                                                                            \
+    }
+
+#define CALLBACK_STREAM(M, Req, Msg)                                                   \
+    grpc::ServerWriteReactor<Msg> *M(grpc::CallbackServerContext *ctx,                 \
+                                     const Req *req) override {                        \
+        return new StreamReactor<Msg>([this, ctx, req](StreamSink<Msg> *sink) {        \
+            ScopedCall call(ctx);                                                      \
+            return b_->M(ctx, req, sink);                                              \
+        });                                                                            \
+    }
+
+#define CALLBACK_BIDI(M, In, Out)                                                      \
+    grpc::ServerBidiReactor<In, Out> *M(grpc::CallbackServerContext *ctx) override {   \
+        return new BidiReactor<In, Out>([this, ctx](BidiStream<In, Out> *io) {         \
+            ScopedCall call(ctx);                                                      \
+            return b_->M(ctx, io);                                                     \
+        });                                                                            \
+    }
+
+class ToolCallbackService final : public ToolRawMetadata<apb::ToolService::CallbackService> {
+    ToolBridge *b_;
+    WorkerPool *pool_;
+public:
+    ToolCallbackService(ToolBridge *b, WorkerPool *pool) : b_(b), pool_(pool) {
+        b_->SetDispatcher([pool](std::function<void()> fn) { pool->Submit(std::move(fn)); });
+    }
+    CALLBACK_HEALTH()
+    RAW_UNARY(Name)
+    RAW_UNARY(Description)
+    RAW_UNARY(Schema)
+    CALLBACK_UNARY(RequiresApproval, apb::Empty, apb::ApprovalResponse)
+    CALLBACK_UNARY(Configure, apb::SettingsMap, apb::Empty)
+    CALLBACK_UNARY(ListTools, apb::ListToolsRequest, apb::ListToolsResponse)
+    CALLBACK_STREAM(ExecuteStream, apb::ExecuteRequest, apb::ExecuteChunk)
+    CALLBACK_UNARY(ExecuteBatch, apb::ExecuteBatchRequest, apb::ExecuteBatchResponse)
+    CALLBACK_STREAM(ExecuteBatchStream, apb::ExecuteBatchRequest, apb::ExecuteBatchResult)
+
+    /* Finishes from the handler's completion, so async executions hold no worker. */
+    grpc::ServerUnaryReactor *Execute(grpc::CallbackServerContext *ctx,
+                                      const apb::ExecuteRequest *req,
+                                      apb::ExecuteResponse *resp) override {
+        grpc::ServerUnaryReactor *reactor = ctx->DefaultReactor();
+        pool_->Submit([this, ctx, req, resp, reactor] {
+            b_->ExecuteAsync(ctx, req, resp, [reactor](grpc::Status s) { reactor->Finish(s); });
+        });
+        return reactor;
+    }
+};
+
+class ChannelCallbackService final : public apb::ChannelService::CallbackService {
+    ChannelBridge *b_;
+    WorkerPool *pool_;
+public:
+    ChannelCallbackService(ChannelBridge *b, WorkerPool *pool) : b_(b), pool_(pool) {}
+    CALLBACK_HEALTH()
+    CALLBACK_UNARY(ID, apb::Empty, apb::IDResponse)
+    CALLBACK_UNARY(Connect, apb::ChannelConnectRequest, apb::ChannelConnectResponse)
+    CALLBACK_UNARY(Disconnect, apb::Empty, apb::ChannelDisconnectResponse)
+    CALLBACK_UNARY(Send, apb::ChannelSendRequest, apb::ChannelSendResponse)
+    CALLBACK_STREAM(Receive, apb::Empty, apb::InboundMessage)
+    CALLBACK_UNARY(Configure, apb::SettingsMap, apb::Empty)
+};
+
+class GatewayCallbackService final : public apb::GatewayService::CallbackService {
+    GatewayBridge *b_;
+    WorkerPool *pool_;
+public:
+    GatewayCallbackService(GatewayBridge *b, WorkerPool *pool) : b_(b), pool_(pool) {}
+    CALLBACK_HEALTH()
+    CALLBACK_STREAM(Stream, apb::GatewayRequest, apb::GatewayEvent)
+    CALLBACK_UNARY(Cancel, apb::CancelRequest, apb::CancelResponse)
+    CALLBACK_UNARY(Configure, apb::SettingsMap, apb::Empty)
+
+    /* A Poll may wait up to kPollWait for an event, so it is neither run on
+     * the workers that serve unary calls nor given a thread: it parks with
+     * the poller, and the event or the timeout finishes it. */
+    grpc::ServerUnaryReactor *Poll(grpc::CallbackServerContext *ctx, const apb::PollRequest *req,
+                                   apb::PollResponse *resp) override {
+        grpc::ServerUnaryReactor *reactor = ctx->DefaultReactor();
+        b_->PollAsync(ctx, req, resp, [reactor](grpc::Status st) { reactor->Finish(st); });
+        return reactor;
+    }
+};
+
+class UICallbackService final : public apb::UIService::CallbackService {
+    UIBridge *b_;
+    WorkerPool *pool_;
+public:
+    UICallbackService(UIBridge *b, WorkerPool *pool) : b_(b), pool_(pool) {}
+    CALLBACK_HEALTH()
+    CALLBACK_UNARY(HandleRequest, apb::HttpRequest, apb::HttpResponse)
+    CALLBACK_BIDI(HandleRequestStream, apb::HttpRequestChunk, apb::HttpResponseChunk)
+    CALLBACK_UNARY(Configure, apb::SettingsMap, apb::Empty)
+};
+
+class CommCallbackService final : public apb::CommService::CallbackService {
+    CommBridge *b_;
+    WorkerPool *pool_;
+public:
+    CommCallbackService(CommBridge *b, WorkerPool *pool) : b_(b), pool_(pool) {}
+    CALLBACK_HEALTH()
+    CALLBACK_UNARY(Name, apb::Empty, apb::CommNameResponse)
+    CALLBACK_UNARY(Version, apb::Empty, apb::CommVersionResponse)
+    CALLBACK_UNARY(Connect, apb::CommConnectRequest, apb::CommConnectResponse)
+    CALLBACK_UNARY(Disconnect, apb::Empty, apb::CommDisconnectResponse)
+    CALLBACK_UNARY(IsConnected, apb::Empty, apb::CommIsConnectedResponse)
+    CALLBACK_UNARY(Send, apb::CommSendRequest, apb::CommSendResponse)
+    CALLBACK_UNARY(Subscribe, apb::CommSubscribeRequest, apb::CommSubscribeResponse)
+    CALLBACK_UNARY(Unsubscribe, apb::CommUnsubscribeRequest, apb::CommUnsubscribeResponse)
+    CALLBACK_UNARY(Register, apb::CommRegisterRequest, apb::CommRegisterResponse)
+    CALLBACK_UNARY(Deregister, apb::Empty, apb::CommDeregisterResponse)
+    CALLBACK_STREAM(Receive, apb::Empty, apb::CommMessage)
+    CALLBACK_UNARY(Configure, apb::SettingsMap, apb::Empty)
+};
+
+class ScheduleCallbackService final : public apb::ScheduleService::CallbackService {
+    ScheduleBridge *b_;
+    WorkerPool *pool_;
+public:
+    ScheduleCallbackService(ScheduleBridge *b, WorkerPool *pool) : b_(b), pool_(pool) {}
+    CALLBACK_HEALTH()
+    CALLBACK_UNARY(Create, apb::CreateScheduleRequest, apb::ScheduleResponse)
+    CALLBACK_UNARY(Get, apb::GetScheduleRequest, apb::ScheduleResponse)
+    CALLBACK_UNARY(List, apb::ListSchedulesRequest, apb::ListSchedulesResponse)
+    CALLBACK_UNARY(Update, apb::UpdateScheduleRequest, apb::ScheduleResponse)
+    CALLBACK_UNARY(Delete, apb::DeleteScheduleRequest, apb::DeleteScheduleResponse)
+    CALLBACK_UNARY(Enable, apb::ScheduleNameRequest, apb::ScheduleResponse)
+    CALLBACK_UNARY(Disable, apb::ScheduleNameRequest, apb::ScheduleResponse)
+    CALLBACK_UNARY(Trigger, apb::ScheduleNameRequest, apb::TriggerResponse)
+    CALLBACK_UNARY(History, apb::ScheduleHistoryRequest, apb::ScheduleHistoryResponse)
+    CALLBACK_STREAM(Triggers, apb::Empty, apb::ScheduleTrigger)
+    CALLBACK_UNARY(Configure, apb::SettingsMap, apb::Empty)
+};
+
 /* ── Server entry point ──────────────────────────────────────────────── */
 
 static std::unique_ptr<grpc::Server> g_server;
+static int g_shutdown_pipe[2] = {-1, -1};
 
+/* Server::Shutdown() is not async-signal-safe; wake a watcher thread instead. */
 static void signal_handler(int) {
-    if (g_server) g_server->Shutdown();
+    char c = 0;
+    if (write(g_shutdown_pipe[1], &c, 1) < 0) { /* nothing to do */ }
+}
+
+/**
+ * Registers one capability's bridge with the builder, wrapped in the
+ * service type for the selected engine. Owns everything it creates.
+ */
+template <class Bridge, class SyncSvc, class CallbackSvc, class Handler>
+static void add_bridge(grpc::ServerBuilder &builder, const Handler *h, nebo_app_t *app,
+                       WorkerPool *pool, std::vector<std::shared_ptr<void>> &owned) {
+    if (!h) return;
+    auto bridge = std::make_shared<Bridge>(h, app);
+    owned.push_back(bridge);
+    if (pool) {
+        auto svc = std::make_shared<CallbackSvc>(bridge.get(), pool);
+        owned.push_back(svc);
+        builder.RegisterService(svc.get());
+    } else {
+        auto svc = std::make_shared<SyncSvc>(bridge.get());
+        owned.push_back(svc);
+        builder.RegisterService(svc.get());
+    }
 }
 
 extern "C" int nebo_grpc_serve(nebo_app_t *app) {
@@ -870,64 +2395,59 @@ extern "C" int nebo_grpc_serve(nebo_app_t *app) {
 
     grpc::ServerBuilder builder;
     builder.AddListeningPort(addr, grpc::InsecureServerCredentials());
+    /* The only peer is the local host over a Unix socket; don't cap tool inputs at 4 MB. */
+    builder.SetMaxReceiveMessageSize(-1);
 
-    /* Conditionally register bridges for each non-NULL handler */
-    ToolBridge     *tool_bridge     = nullptr;
-    ChannelBridge  *channel_bridge  = nullptr;
-    GatewayBridge  *gateway_bridge  = nullptr;
-    UIBridge       *ui_bridge       = nullptr;
-    CommBridge     *comm_bridge     = nullptr;
-    ScheduleBridge *schedule_bridge = nullptr;
-
-    if (app->tool) {
-        tool_bridge = new ToolBridge(app->tool, app);
-        builder.RegisterService(tool_bridge);
-    }
-    if (app->channel) {
-        channel_bridge = new ChannelBridge(app->channel, app);
-        builder.RegisterService(channel_bridge);
-    }
-    if (app->gateway) {
-        gateway_bridge = new GatewayBridge(app->gateway, app);
-        builder.RegisterService(gateway_bridge);
-    }
-    if (app->ui) {
-        ui_bridge = new UIBridge(app->ui, app);
-        builder.RegisterService(ui_bridge);
-    }
-    if (app->comm) {
-        comm_bridge = new CommBridge(app->comm, app);
-        builder.RegisterService(comm_bridge);
-    }
-    if (app->schedule) {
-        schedule_bridge = new ScheduleBridge(app->schedule, app);
-        builder.RegisterService(schedule_bridge);
+    std::unique_ptr<WorkerPool> pool;
+    if (app->engine == NEBO_ENGINE_CALLBACK) {
+        int threads = app->threads > 0 ? app->threads : (int)std::thread::hardware_concurrency();
+        pool.reset(new WorkerPool(threads > 0 ? threads : 1));
     }
 
+    /* Conditionally register bridges for each non-NULL handler */
+    std::vector<std::shared_ptr<void>> owned;
+    add_bridge<ToolBridge, ToolSyncService, ToolCallbackService>(
+        builder, app->tool_count ? app->tools : nullptr, app, pool.get(), owned);
+    add_bridge<ChannelBridge, ChannelSyncService, ChannelCallbackService>(
+        builder, app->channel, app, pool.get(), owned);
+    add_bridge<GatewayBridge, GatewaySyncService, GatewayCallbackService>(
+        builder, app->gateway, app, pool.get(), owned);
+    add_bridge<UIBridge, UISyncService, UICallbackService>(
+        builder, app->ui ? app->ui : app->static_prefix ? &kStaticOnly : nullptr, app,
+        pool.get(), owned);
+    add_bridge<CommBridge, CommSyncService, CommCallbackService>(
+        builder, app->comm, app, pool.get(), owned);
+    add_bridge<ScheduleBridge, ScheduleSyncService, ScheduleCallbackService>(
+        builder, app->schedule, app, pool.get(), owned);
+
     g_server = builder.BuildAndStart();
     if (!g_server) {
         fprintf(stderr, "Failed to start gRPC server on %s\n", app->sock_path);
-        delete tool_bridge;
-        delete channel_bridge;
-        delete gateway_bridge;
-        delete ui_bridge;
-        delete comm_bridge;
-        delete schedule_bridge;
         return 1;
     }
 
     /* Graceful shutdown on SIGTERM/SIGINT */
+    if (pipe(g_shutdown_pipe) != 0) {
+        fprintf(stderr, "Failed to create shutdown pipe\n");
+        g_server->Shutdown();
+        g_server.reset();
+        return 1;
+    }
+    std::thread watcher([] {
+        char c;
+        while (read(g_shutdown_pipe[0], &c, 1) < 0 && errno == EINTR) {}
+        g_server->Shutdown();
+    });
     signal(SIGTERM, signal_handler);
     signal(SIGINT, signal_handler);
 
     g_server->Wait();
+    watcher.join();
+    close(g_shutdown_pipe[0]);
+    close(g_shutdown_pipe[1]);
 
+    /* Server first (waits out in-flight calls), then the pool, then bridges. */
     g_server.reset();
-    delete tool_bridge;
-    delete channel_bridge;
-    delete gateway_bridge;
-    delete ui_bridge;
-    delete comm_bridge;
-    delete schedule_bridge;
+    pool.reset();
     return 0;
 }
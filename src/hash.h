@@ -0,0 +1,21 @@
+#ifndef NEBO_HASH_H
+#define NEBO_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * 64-bit FNV-1a. Fast and good enough for in-process tables and cache keys;
+ * not for anything adversarial.
+ */
+static inline uint64_t nebo_fnv1a(const void *data, size_t len) {
+    const unsigned char *p = (const unsigned char *)data;
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+#endif /* NEBO_HASH_H */
@@ -0,0 +1,212 @@
+/**
+ * Nebo C SDK — response cache for idempotent UI requests.
+ */
+
+#include "http_cache.h"
+#include "http_headers.h"
+#include "call_context.h"
+
+#include <cstdlib>
+#include <strings.h>
+
+extern "C" {
+#include "hash.h"
+}
+
+namespace apb = apps::v0;
+
+static const size_t kDefaultMaxBytes = 16u << 20;
+
+/* Caches by handler, so nebo_ui_cache_stats can find a served handler. */
+static std::mutex g_registry_mu;
+static std::unordered_map<const nebo_ui_handler_t *, HttpCache *> g_registry;
+
+size_t HttpCache::KeyHash::operator()(const std::string &s) const {
+    return (size_t)nebo_fnv1a(s.data(), s.size());
+}
+
+HttpCache::HttpCache(const nebo_ui_handler_t *ui)
+    : ui_(ui), max_bytes_(ui->cache_max_bytes ? ui->cache_max_bytes : kDefaultMaxBytes) {
+    for (const char *const *v = ui->cache_vary; v && *v; v++) vary_.emplace_back(*v);
+    std::lock_guard<std::mutex> lk(g_registry_mu);
+    g_registry[ui_] = this;
+}
+
+HttpCache::~HttpCache() {
+    std::lock_guard<std::mutex> lk(g_registry_mu);
+    auto it = g_registry.find(ui_);
+    if (it != g_registry.end() && it->second == this) g_registry.erase(it);
+}
+
+/* GET and HEAD share keys; a header in cache_vary that is absent differs from an empty one. */
+std::string HttpCache::Key(const apb::HttpRequest &req) const {
+    std::string key = req.path();
+    key += '\0';
+    key += req.query();
+    for (const std::string &name : vary_) {
+        const std::string *value = http_find_header(req.headers(), name.c_str());
+        key += value ? '\0' : '\1';
+        if (value) key += *value;
+    }
+    return key;
+}
+
+/**
+ * Whether resp may be stored, and for how long. open reports whether it
+ * says public or s-maxage; a response to a request with credentials is
+ * per-user unless it does, so it is stored only then.
+ */
+bool HttpCache::Fresh(const apb::HttpResponse &resp, bool credentialed, std::chrono::seconds *ttl,
+                      bool *open) const {
+    if (resp.status_code() == 206 || http_find_header(resp.headers(), "Set-Cookie")) return false;
+    const std::string *cc = http_find_header(resp.headers(), "Cache-Control");
+    if (!cc) return false;
+    long max_age = -1, s_maxage = -1;
+    bool is_public = false;
+    bool denied = http_any_element(*cc, [&](const std::string &d, const std::string &) {
+        if (strncasecmp(d.c_str(), "max-age=", 8) == 0) max_age = atol(d.c_str() + 8);
+        else if (strncasecmp(d.c_str(), "s-maxage=", 9) == 0) s_maxage = atol(d.c_str() + 9);
+        else if (strcasecmp(d.c_str(), "public") == 0) is_public = true;
+        return strncasecmp(d.c_str(), "no-store", 8) == 0 ||
+               strncasecmp(d.c_str(), "no-cache", 8) == 0 ||
+               strncasecmp(d.c_str(), "private", 7) == 0;
+    });
+    long secs = s_maxage >= 0 ? s_maxage : max_age; /* s-maxage wins in a shared cache */
+    if (denied || secs <= 0) return false;
+    *open = is_public || s_maxage >= 0;
+    if (credentialed && !*open) return false;
+
+    /* The key must cover every header the response varies on. */
+    const std::string *vary = http_find_header(resp.headers(), "Vary");
+    if (vary && http_any_element(*vary, [this](const std::string &h, const std::string &) {
+            for (const std::string &name : vary_) {
+                if (strcasecmp(name.c_str(), h.c_str()) == 0) return false;
+            }
+            return true;
+        }))
+        return false;
+    *ttl = std::chrono::seconds(secs);
+    return true;
+}
+
+/* How often a joined request rechecks its own call while the flight runs. */
+static const auto kJoinRecheck = std::chrono::milliseconds(20);
+
+grpc::Status HttpCache::Serve(const apb::HttpRequest &req, apb::HttpResponse *resp,
+                              const Run &run) {
+    bool head = req.method() == "HEAD";
+    if (!head && req.method() != "GET") return run(resp);
+    bool credentialed = http_find_header(req.headers(), "Authorization") ||
+                        http_find_header(req.headers(), "Cookie");
+    std::string key = Key(req);
+    std::shared_ptr<Flight> flight;
+    Shared hit;
+    Clock::time_point stored;
+    {
+        std::unique_lock<std::mutex> lk(mu_);
+        auto it = index_.find(key);
+        Clock::time_point now = Clock::now();
+        if (it != index_.end() && now >= it->second->expires) {
+            EraseLocked(it->second);
+            stats_.evictions++;
+            it = index_.end();
+        }
+        if (it != index_.end() && (!credentialed || it->second->open)) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            hit = it->second->resp;
+            stored = it->second->stored;
+            stats_.hits++;
+        } else {
+            auto joined = head ? flights_.end() : flights_.find(key);
+            if (joined != flights_.end()) {
+                std::shared_ptr<Flight> f = joined->second;
+                stats_.collapsed++;
+                nebo_call *call = nebo_call_current();
+                while (!landed_.wait_for(lk, kJoinRecheck, [&f] { return f->done; })) {
+                    if (call && call->Cancelled()) {
+                        return call->DeadlineMs() == 0
+                                   ? grpc::Status(grpc::DEADLINE_EXCEEDED, "deadline exceeded")
+                                   : grpc::Status(grpc::CANCELLED, "request cancelled");
+                    }
+                }
+                Shared landed = f->shared && (!credentialed || f->open) ? f->resp : nullptr;
+                lk.unlock();
+                if (landed) {
+                    *resp = *landed;
+                    return grpc::Status::OK;
+                }
+                /* Not shareable (private, no-store, ...): ask the handler ourselves. */
+                return run(resp);
+            }
+            stats_.misses++;
+            if (head) {
+                lk.unlock();
+                return run(resp); /* a HEAD response has no body to store for GET */
+            }
+            flight = std::make_shared<Flight>();
+            flights_.emplace(key, flight);
+        }
+    }
+    if (hit) {
+        /* Copy outside the lock so large bodies don't serialize other hits. */
+        *resp = *hit;
+        if (head) resp->clear_body();
+        auto age = std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - stored);
+        (*resp->mutable_headers())["Age"] = std::to_string(age.count());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status status = run(resp);
+    std::chrono::seconds ttl{};
+    bool open = false;
+    bool cacheable = status.ok() && Fresh(*resp, credentialed, &ttl, &open);
+    Shared stored_resp = cacheable ? std::make_shared<const apb::HttpResponse>(*resp) : nullptr;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (cacheable) Insert(key, stored_resp, open, ttl);
+        flight->done = true;
+        flight->shared = cacheable;
+        flight->open = open;
+        flight->resp = std::move(stored_resp);
+        flights_.erase(key);
+    }
+    landed_.notify_all();
+    return status;
+}
+
+void HttpCache::Insert(const std::string &key, Shared resp, bool open, std::chrono::seconds ttl) {
+    size_t size = key.size() + resp->ByteSizeLong();
+    if (size > max_bytes_) return;
+    auto old = index_.find(key);
+    if (old != index_.end()) EraseLocked(old->second);
+    while (stats_.bytes + size > max_bytes_ && !lru_.empty()) {
+        EraseLocked(std::prev(lru_.end()));
+        stats_.evictions++;
+    }
+    Clock::time_point now = Clock::now();
+    lru_.push_front(Entry{key, std::move(resp), open, size, now, now + ttl});
+    index_.emplace(key, lru_.begin());
+    stats_.bytes += size;
+    stats_.entries++;
+}
+
+void HttpCache::EraseLocked(std::list<Entry>::iterator it) {
+    stats_.bytes -= it->size;
+    stats_.entries--;
+    index_.erase(it->key);
+    lru_.erase(it);
+}
+
+nebo_http_cache_stats_t HttpCache::Stats() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return stats_;
+}
+
+extern "C" int nebo_ui_cache_stats(const nebo_ui_handler_t *ui, nebo_http_cache_stats_t *out) {
+    if (!ui || !out) return -1;
+    std::lock_guard<std::mutex> lk(g_registry_mu);
+    auto it = g_registry.find(ui);
+    if (it == g_registry.end()) return -1;
+    *out = it->second->Stats();
+    return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * Nebo C SDK — response cache for idempotent UI requests.
+ *
+ * Internal to the C++ shim. The UI bridge puts one HttpCache in front of
+ * handle_request when the handler is registered with cache = 1.
+ */
+
+#ifndef NEBO_HTTP_CACHE_H
+#define NEBO_HTTP_CACHE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+#include "proto/apps/v0/ui.pb.h"
+
+extern "C" {
+#include "nebo/ui.h"
+}
+
+/**
+ * Byte-bounded LRU of GET responses with per-entry expiry from the
+ * response's Cache-Control, and single-flight for identical misses.
+ */
+class HttpCache {
+public:
+    using Run = std::function<grpc::Status(apps::v0::HttpResponse *)>;
+
+    explicit HttpCache(const nebo_ui_handler_t *ui);
+    ~HttpCache();
+
+    /**
+     * Answers a GET or HEAD from the cache or joins an identical in-flight
+     * GET; otherwise calls run, and stores what a GET returned if it is
+     * cacheable. Other methods just call run. Blocks while joined, until
+     * the flight lands or the current nebo_call is cancelled or expires.
+     */
+    grpc::Status Serve(const apps::v0::HttpRequest &req, apps::v0::HttpResponse *resp,
+                       const Run &run);
+
+    nebo_http_cache_stats_t Stats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    using Shared = std::shared_ptr<const apps::v0::HttpResponse>;
+
+    struct Entry {
+        std::string key;
+        Shared resp;     /* copied outside mu_ by hits */
+        bool open;       /* public or s-maxage: may answer credentialed requests */
+        size_t size;
+        Clock::time_point stored;
+        Clock::time_point expires;
+    };
+
+    /* One in-flight GET; waiters hold a reference until it lands. */
+    struct Flight {
+        bool done = false;
+        bool shared = false; /* resp holds the cacheable result */
+        bool open = false;   /* ... which credentialed waiters may take too */
+        Shared resp;
+    };
+
+    struct KeyHash {
+        size_t operator()(const std::string &s) const;
+    };
+
+    std::string Key(const apps::v0::HttpRequest &req) const;
+    bool Fresh(const apps::v0::HttpResponse &resp, bool credentialed, std::chrono::seconds *ttl,
+               bool *open) const;
+    void Insert(const std::string &key, Shared resp, bool open, std::chrono::seconds ttl);
+    void EraseLocked(std::list<Entry>::iterator it);
+
+    const nebo_ui_handler_t *ui_;
+    size_t max_bytes_;
+    std::vector<std::string> vary_;
+
+    std::mutex mu_;
+    std::condition_variable landed_; /* a flight finished */
+    std::list<Entry> lru_;           /* front = most recently used */
+    std::unordered_map<std::string, std::list<Entry>::iterator, KeyHash> index_;
+    std::unordered_map<std::string, std::shared_ptr<Flight>, KeyHash> flights_;
+    nebo_http_cache_stats_t stats_{};
+};
+
+#endif /* NEBO_HTTP_CACHE_H */
@@ -0,0 +1,48 @@
+/**
+ * Nebo C SDK — HTTP header helpers for the UI bridge.
+ *
+ * Internal to the C++ shim; shared by the static asset server and the
+ * response cache.
+ */
+
+#ifndef NEBO_HTTP_HEADERS_H
+#define NEBO_HTTP_HEADERS_H
+
+#include <string>
+#include <strings.h>
+
+#include <google/protobuf/map.h>
+
+using HeaderMap = google::protobuf::Map<std::string, std::string>;
+
+/** Case-insensitive lookup; nullptr if absent. */
+static inline const std::string *http_find_header(const HeaderMap &headers, const char *name) {
+    for (auto &kv : headers) {
+        if (strcasecmp(kv.first.c_str(), name) == 0) return &kv.second;
+    }
+    return nullptr;
+}
+
+/**
+ * Calls fn(token, params) for each comma-separated element of a header
+ * list, trimmed; params is whatever follows the first ';', or empty.
+ * Stops at, and returns true for, the first element fn accepts.
+ */
+template <class F>
+static bool http_any_element(const std::string &list, F fn) {
+    size_t i = 0;
+    while (i < list.size()) {
+        size_t end = list.find(',', i);
+        if (end == std::string::npos) end = list.size();
+        size_t b = i, e = end;
+        while (b < e && (list[b] == ' ' || list[b] == '\t')) b++;
+        while (e > b && (list[e - 1] == ' ' || list[e - 1] == '\t')) e--;
+        size_t semi = list.find(';', b);
+        if (semi == std::string::npos || semi > e) semi = e;
+        if (fn(list.substr(b, semi - b), list.substr(semi, e - semi))) return true;
+        i = end + 1;
+    }
+    return false;
+}
+
+#endif /* NEBO_HTTP_HEADERS_H */
@@ -0,0 +1,537 @@
+/**
+ * Nebo C SDK — compiled schema validator and typed input view.
+ *
+ * A validator is the builder's properties laid out for lookup: a power-of-two
+ * open-addressing table maps a property name to its index, so each input key
+ * costs one hash and usually one compare. Validation is a single
+ * recursive-descent pass over the input that checks JSON syntax, types and
+ * enums while recording the values of declared properties.
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+#include "arena.h"
+#include "hash.h"
+#include "json_lex.h"
+
+#define MAX_DEPTH 128
+
+typedef enum { PROP_STRING, PROP_NUMBER, PROP_BOOL, PROP_OBJECT } prop_type_t;
+
+typedef struct {
+    const char *name;
+    size_t name_len;
+    prop_type_t type;
+    int required;
+    const char **enum_values; /* NULL if not an enum */
+    size_t *enum_lens;
+    int enum_count;
+} vprop_t;
+
+struct nebo_validator {
+    nebo_arena_t arena;
+    vprop_t *props;   /* props[0] is "action" when has_action */
+    int prop_count;
+    int has_action;
+    int *slots;       /* prop index, -1 = empty */
+    size_t mask;
+};
+
+typedef struct {
+    int present;
+    const char *str;  /* strings: unescaped, NUL-terminated; objects: raw text */
+    size_t len;
+    double number;
+    int boolean;
+} input_value_t;
+
+struct nebo_input {
+    nebo_arena_t arena; /* owns this struct and everything it points to */
+    const nebo_validator_t *v;
+    input_value_t *values;
+};
+
+/* ── Validator ───────────────────────────────────────────────────────── */
+
+static int find_prop(const nebo_validator_t *v, const char *name, size_t len) {
+    uint64_t hash = nebo_fnv1a(name, len);
+    for (size_t i = hash & v->mask; v->slots[i] >= 0; i = (i + 1) & v->mask) {
+        const vprop_t *p = &v->props[v->slots[i]];
+        if (p->name_len == len && memcmp(p->name, name, len) == 0) return v->slots[i];
+    }
+    return -1;
+}
+
+static int add_vprop(nebo_validator_t *v, const char *name, prop_type_t type, int required,
+                     char *const *values, int value_count) {
+    nebo_arena_t *a = &v->arena;
+    size_t len = strlen(name);
+    int existing = find_prop(v, name, len);
+    int idx = existing >= 0 ? existing : v->prop_count++;
+    vprop_t *p = &v->props[idx];
+    p->name = nebo_arena_strndup(a, name, len);
+    p->name_len = len;
+    p->type = type;
+    p->required = required;
+    p->enum_values = NULL;
+    p->enum_lens = NULL;
+    p->enum_count = 0;
+    if (!p->name) return -1;
+    if (values && value_count > 0) {
+        p->enum_values = nebo_arena_alloc(a, value_count * sizeof(char *));
+        p->enum_lens = nebo_arena_alloc(a, value_count * sizeof(size_t));
+        if (!p->enum_values || !p->enum_lens) return -1;
+        for (int i = 0; i < value_count; i++) {
+            p->enum_lens[i] = strlen(values[i]);
+            p->enum_values[i] = nebo_arena_strndup(a, values[i], p->enum_lens[i]);
+            if (!p->enum_values[i]) return -1;
+        }
+        p->enum_count = value_count;
+    }
+    if (existing < 0) {
+        size_t i = nebo_fnv1a(name, len) & v->mask;
+        while (v->slots[i] >= 0) i = (i + 1) & v->mask;
+        v->slots[i] = idx;
+    }
+    return 0;
+}
+
+static prop_type_t prop_type(const char *type) {
+    if (strcmp(type, "number") == 0)  return PROP_NUMBER;
+    if (strcmp(type, "boolean") == 0) return PROP_BOOL;
+    if (strcmp(type, "object") == 0)  return PROP_OBJECT;
+    return PROP_STRING;
+}
+
+nebo_validator_t *nebo_schema_compile(const nebo_schema_builder_t *b) {
+    if (!b) return NULL;
+    nebo_arena_t a;
+    nebo_arena_init(&a, 0);
+    nebo_validator_t *v = nebo_arena_alloc(&a, sizeof(nebo_validator_t));
+    if (!v) {
+        nebo_arena_free(&a);
+        return NULL;
+    }
+    memset(v, 0, sizeof(*v));
+
+    int max_props = b->prop_count + 1;
+    size_t cap = 2;
+    while (cap < (size_t)max_props * 2) cap <<= 1;
+    v->props = nebo_arena_alloc(&a, max_props * sizeof(vprop_t));
+    v->slots = nebo_arena_alloc(&a, cap * sizeof(int));
+    v->arena = a;
+    if (!v->props || !v->slots) {
+        nebo_validator_free(v);
+        return NULL;
+    }
+    v->mask = cap - 1;
+    for (size_t i = 0; i < cap; i++) v->slots[i] = -1;
+
+    int failed = 0;
+    if (b->action_count > 0) {
+        v->has_action = 1;
+        failed |= add_vprop(v, "action", PROP_STRING, 1, b->actions, b->action_count);
+    }
+    for (int i = 0; i < b->prop_count; i++) {
+        const schema_prop_t *p = &b->props[i];
+        failed |= add_vprop(v, p->name, prop_type(p->type), p->required,
+                            p->enum_values, p->enum_count);
+    }
+    if (failed) {
+        nebo_validator_free(v);
+        return NULL;
+    }
+    return v;
+}
+
+void nebo_validator_free(nebo_validator_t *v) {
+    if (!v) return;
+    /* v lives in its own arena; copy the handle out before releasing it. */
+    nebo_arena_t a = v->arena;
+    nebo_arena_free(&a);
+}
+
+/* ── Parser ──────────────────────────────────────────────────────────── */
+
+typedef struct {
+    const char *start;
+    const char *p;
+    const char *end;
+    nebo_arena_t *arena;
+    char *err;
+    size_t errlen;
+} parser_t;
+
+static int fail(parser_t *ps, const char *fmt, ...) {
+    if (ps->err && ps->errlen) {
+        va_list ap;
+        va_start(ap, fmt);
+        vsnprintf(ps->err, ps->errlen, fmt, ap);
+        va_end(ap);
+    }
+    return -1;
+}
+
+static int syntax_error(parser_t *ps) {
+    if (ps->p >= ps->end) return fail(ps, "invalid JSON: unexpected end of input");
+    return fail(ps, "invalid JSON at offset %zu", (size_t)(ps->p - ps->start));
+}
+
+static void skip_ws(parser_t *ps) {
+    while (ps->p < ps->end &&
+           (*ps->p == ' ' || *ps->p == '\t' || *ps->p == '\n' || *ps->p == '\r'))
+        ps->p++;
+}
+
+/**
+ * Parse a string at ps->p (on the opening quote). With out set, stores the
+ * unescaped value: a slice of the input when it has no escapes and copy is
+ * 0, otherwise a NUL-terminated arena copy.
+ */
+static int parse_string(parser_t *ps, const char **out, size_t *out_len, int copy) {
+    const char *s = ++ps->p;
+    int escaped = 0;
+    while (ps->p < ps->end && *ps->p != '"') {
+        unsigned char c = (unsigned char)*ps->p;
+        if (c < 0x20) return syntax_error(ps);
+        if (c == '\\') {
+            escaped = 1;
+            if (++ps->p >= ps->end) return syntax_error(ps);
+            switch (*ps->p) {
+            case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+                break;
+            case 'u': {
+                unsigned cp;
+                if (ps->end - ps->p < 5 || nebo_json_hex4(ps->p + 1, &cp) != 0) return syntax_error(ps);
+                ps->p += 4;
+                break;
+            }
+            default:
+                return syntax_error(ps);
+            }
+        }
+        ps->p++;
+    }
+    if (ps->p >= ps->end) return syntax_error(ps);
+    size_t raw_len = (size_t)(ps->p - s);
+    ps->p++; /* closing quote */
+    if (!out) return 0;
+
+    if (!escaped) {
+        *out = copy ? nebo_arena_strndup(ps->arena, s, raw_len) : s;
+        *out_len = raw_len;
+        return *out ? 0 : fail(ps, "out of memory");
+    }
+
+    /* Unescaped text is never longer than the escaped source. */
+    char *buf = nebo_arena_alloc(ps->arena, raw_len + 1);
+    if (!buf) return fail(ps, "out of memory");
+    size_t n = 0;
+    for (const char *q = s; q < s + raw_len; q++) {
+        if (*q != '\\') {
+            buf[n++] = *q;
+            continue;
+        }
+        switch (*++q) {
+        case 'b': buf[n++] = '\b'; break;
+        case 'f': buf[n++] = '\f'; break;
+        case 'n': buf[n++] = '\n'; break;
+        case 'r': buf[n++] = '\r'; break;
+        case 't': buf[n++] = '\t'; break;
+        case 'u': {
+            unsigned cp, lo;
+            nebo_json_hex4(q + 1, &cp);
+            q += 4;
+            if (cp >= 0xD800 && cp <= 0xDBFF && q + 6 < s + raw_len &&
+                q[1] == '\\' && q[2] == 'u' && nebo_json_hex4(q + 3, &lo) == 0 &&
+                lo >= 0xDC00 && lo <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                q += 6;
+            }
+            n += nebo_json_put_utf8(buf + n, cp);
+            break;
+        }
+        default: buf[n++] = *q; break; /* " \ / */
+        }
+    }
+    buf[n] = '\0';
+    *out = buf;
+    *out_len = n;
+    return 0;
+}
+
+static int parse_number(parser_t *ps, double *out) {
+    const char *s = ps->p;
+    const char *q;
+    if (nebo_json_scan_number(s, ps->end, &q) != 0) {
+        ps->p = q;
+        return syntax_error(ps);
+    }
+    ps->p = q;
+    if (out) {
+        /* The input need not be NUL-terminated; the C-locale strtod gets a
+         * bounded copy. */
+        char tmp[64];
+        size_t len = (size_t)(q - s);
+        if (len < sizeof(tmp)) {
+            memcpy(tmp, s, len);
+            tmp[len] = '\0';
+            *out = nebo_json_strtod(tmp);
+        } else {
+            char *big = nebo_arena_strndup(ps->arena, s, len);
+            if (!big) return fail(ps, "out of memory");
+            *out = nebo_json_strtod(big);
+        }
+    }
+    return 0;
+}
+
+static int parse_literal(parser_t *ps, const char *lit, size_t len) {
+    if ((size_t)(ps->end - ps->p) < len || memcmp(ps->p, lit, len) != 0) return syntax_error(ps);
+    ps->p += len;
+    return 0;
+}
+
+/* Validate any JSON value without recording it. */
+static int skip_value(parser_t *ps, int depth) {
+    if (depth > MAX_DEPTH) return fail(ps, "invalid JSON: nesting deeper than %d", MAX_DEPTH);
+    skip_ws(ps);
+    if (ps->p >= ps->end) return syntax_error(ps);
+    switch (*ps->p) {
+    case '"': return parse_string(ps, NULL, NULL, 0);
+    case 't': return parse_literal(ps, "true", 4);
+    case 'f': return parse_literal(ps, "false", 5);
+    case 'n': return parse_literal(ps, "null", 4);
+    case '{': case '[': {
+        char close = *ps->p == '{' ? '}' : ']';
+        int object = close == '}';
+        ps->p++;
+        skip_ws(ps);
+        if (ps->p < ps->end && *ps->p == close) {
+            ps->p++;
+            return 0;
+        }
+        for (;;) {
+            if (object) {
+                skip_ws(ps);
+                if (ps->p >= ps->end || *ps->p != '"') return syntax_error(ps);
+                if (parse_string(ps, NULL, NULL, 0) != 0) return -1;
+                skip_ws(ps);
+                if (ps->p >= ps->end || *ps->p != ':') return syntax_error(ps);
+                ps->p++;
+            }
+            if (skip_value(ps, depth + 1) != 0) return -1;
+            skip_ws(ps);
+            if (ps->p < ps->end && *ps->p == ',') {
+                ps->p++;
+                continue;
+            }
+            if (ps->p < ps->end && *ps->p == close) {
+                ps->p++;
+                return 0;
+            }
+            return syntax_error(ps);
+        }
+    }
+    default:
+        return parse_number(ps, NULL);
+    }
+}
+
+static const char *type_name(prop_type_t t) {
+    switch (t) {
+    case PROP_NUMBER: return "a number";
+    case PROP_BOOL:   return "a boolean";
+    case PROP_OBJECT: return "an object";
+    default:          return "a string";
+    }
+}
+
+static int check_enum(parser_t *ps, const vprop_t *p, const char *s, size_t len) {
+    for (int i = 0; i < p->enum_count; i++) {
+        if (p->enum_lens[i] == len && memcmp(p->enum_values[i], s, len) == 0) return 0;
+    }
+    char allowed[256];
+    size_t pos = 0;
+    allowed[0] = '\0';
+    for (int i = 0; i < p->enum_count && pos < sizeof(allowed); i++)
+        pos += snprintf(allowed + pos, sizeof(allowed) - pos, "%s%s", i ? ", " : "", p->enum_values[i]);
+    return fail(ps, "property \"%s\" must be one of: %s", p->name, allowed);
+}
+
+/* Parse the value of a declared property into val, checking type and enum. */
+static int parse_prop(parser_t *ps, const vprop_t *p, input_value_t *val) {
+    skip_ws(ps);
+    if (ps->p >= ps->end) return syntax_error(ps);
+    char c = *ps->p;
+    switch (p->type) {
+    case PROP_STRING:
+        if (c != '"') break;
+        if (parse_string(ps, &val->str, &val->len, 1) != 0) return -1;
+        if (p->enum_values && check_enum(ps, p, val->str, val->len) != 0) return -1;
+        val->present = 1;
+        return 0;
+    case PROP_NUMBER:
+        if (c != '-' && (c < '0' || c > '9')) break;
+        if (parse_number(ps, &val->number) != 0) return -1;
+        val->present = 1;
+        return 0;
+    case PROP_BOOL:
+        if (c == 't') {
+            if (parse_literal(ps, "true", 4) != 0) return -1;
+            val->boolean = 1;
+        } else if (c == 'f') {
+            if (parse_literal(ps, "false", 5) != 0) return -1;
+            val->boolean = 0;
+        } else {
+            break;
+        }
+        val->present = 1;
+        return 0;
+    case PROP_OBJECT: {
+        if (c != '{') break;
+        const char *s = ps->p;
+        if (skip_value(ps, 1) != 0) return -1;
+        /* Copied, so the view never points into the caller's buffer. */
+        val->len = (size_t)(ps->p - s);
+        val->str = nebo_arena_strndup(ps->arena, s, val->len);
+        if (!val->str) return fail(ps, "out of memory");
+        val->present = 1;
+        return 0;
+    }
+    }
+    /* null counts as absent, so optional properties may be sent as null. */
+    if (c == 'n') {
+        if (parse_literal(ps, "null", 4) != 0) return -1;
+        val->present = 0;
+        return 0;
+    }
+    if (skip_value(ps, 1) != 0) return -1;
+    return fail(ps, "property \"%s\" must be %s", p->name, type_name(p->type));
+}
+
+nebo_input_t *nebo_input_parse(const nebo_validator_t *v, const char *json, size_t len,
+                               char *err, size_t errlen) {
+    if (err && errlen) err[0] = '\0';
+    if (!v || !json) return NULL;
+
+    /* One block fits the view, its values and every string unescaped. */
+    nebo_arena_t a;
+    nebo_arena_init(&a, sizeof(nebo_input_t) + v->prop_count * sizeof(input_value_t) + len + 256);
+    nebo_input_t *in = nebo_arena_alloc(&a, sizeof(nebo_input_t));
+    input_value_t *values = nebo_arena_alloc(&a, v->prop_count * sizeof(input_value_t) + 1);
+    if (!in || !values) {
+        nebo_arena_free(&a);
+        return NULL;
+    }
+    memset(values, 0, v->prop_count * sizeof(input_value_t));
+
+    parser_t ps = {json, json, json + len, &a, err, errlen};
+    int rc = 0;
+    skip_ws(&ps);
+    if (ps.p >= ps.end || *ps.p != '{') {
+        rc = fail(&ps, "input must be a JSON object");
+        goto done;
+    }
+    ps.p++;
+    skip_ws(&ps);
+    if (ps.p < ps.end && *ps.p == '}') {
+        ps.p++;
+    } else {
+        for (;;) {
+            skip_ws(&ps);
+            if (ps.p >= ps.end || *ps.p != '"') { rc = syntax_error(&ps); goto done; }
+            const char *key;
+            size_t key_len;
+            if ((rc = parse_string(&ps, &key, &key_len, 0)) != 0) goto done;
+            skip_ws(&ps);
+            if (ps.p >= ps.end || *ps.p != ':') { rc = syntax_error(&ps); goto done; }
+            ps.p++;
+
+            int idx = find_prop(v, key, key_len);
+            if (idx >= 0) rc = parse_prop(&ps, &v->props[idx], &values[idx]);
+            else          rc = skip_value(&ps, 1); /* undeclared: allowed, not indexed */
+            if (rc != 0) goto done;
+
+            skip_ws(&ps);
+            if (ps.p < ps.end && *ps.p == ',') { ps.p++; continue; }
+            if (ps.p < ps.end && *ps.p == '}') { ps.p++; break; }
+            rc = syntax_error(&ps);
+            goto done;
+        }
+    }
+    skip_ws(&ps);
+    if (ps.p != ps.end) {
+        rc = syntax_error(&ps);
+        goto done;
+    }
+    for (int i = 0; i < v->prop_count; i++) {
+        if (v->props[i].required && !values[i].present) {
+            rc = fail(&ps, "missing required property \"%s\"", v->props[i].name);
+            goto done;
+        }
+    }
+
+done:
+    if (rc != 0) {
+        nebo_arena_free(&a);
+        return NULL;
+    }
+    in->v = v;
+    in->values = values;
+    in->arena = a;
+    return in;
+}
+
+void nebo_input_free(nebo_input_t *in) {
+    if (!in) return;
+    nebo_arena_t a = in->arena;
+    nebo_arena_free(&a);
+}
+
+/* ── Accessors ───────────────────────────────────────────────────────── */
+
+static const input_value_t *lookup(const nebo_input_t *in, const char *name, prop_type_t type) {
+    if (!in || !name) return NULL;
+    int idx = find_prop(in->v, name, strlen(name));
+    if (idx < 0 || in->v->props[idx].type != type || !in->values[idx].present) return NULL;
+    return &in->values[idx];
+}
+
+const char *nebo_input_action(const nebo_input_t *in) {
+    if (!in || !in->v->has_action) return NULL;
+    return in->values[0].str;
+}
+
+int nebo_input_has(const nebo_input_t *in, const char *name) {
+    if (!in || !name) return 0;
+    int idx = find_prop(in->v, name, strlen(name));
+    return idx >= 0 && in->values[idx].present;
+}
+
+double nebo_input_get_number(const nebo_input_t *in, const char *name) {
+    const input_value_t *val = lookup(in, name, PROP_NUMBER);
+    return val ? val->number : 0;
+}
+
+const char *nebo_input_get_string(const nebo_input_t *in, const char *name, size_t *len) {
+    const input_value_t *val = lookup(in, name, PROP_STRING);
+    if (len) *len = val ? val->len : 0;
+    return val ? val->str : NULL;
+}
+
+int nebo_input_get_bool(const nebo_input_t *in, const char *name) {
+    const input_value_t *val = lookup(in, name, PROP_BOOL);
+    return val ? val->boolean : 0;
+}
+
+const char *nebo_input_get_raw(const nebo_input_t *in, const char *name, size_t *len) {
+    const input_value_t *val = lookup(in, name, PROP_OBJECT);
+    if (len) *len = val ? val->len : 0;
+    return val ? val->str : NULL;
+}
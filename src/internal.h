@@ -18,13 +18,44 @@ struct nebo_app {
     char *version;
     char *data_dir;
 
-    const nebo_tool_handler_t *tool;
+    const nebo_tool_handler_t **tools; /* registration order; tools[0] is the default */
+    int tool_count;
     const nebo_channel_handler_t *channel;
     const nebo_gateway_handler_t *gateway;
     const nebo_ui_handler_t *ui;
+    char *static_prefix; /* set by nebo_app_serve_static */
+    char *static_dir;
     const nebo_comm_handler_t *comm;
     const nebo_schedule_handler_t *schedule;
     void (*on_configure)(const nebo_string_map_t *settings);
+
+    nebo_engine_t engine;
+    int threads;
+    int batch_threads;
+};
+
+/**
+ * Full definition of nebo_schema_builder — shared between schema.c, which
+ * builds JSON Schema from it, and input.c, which compiles it to a validator.
+ */
+#define MAX_PROPS 32
+#define MAX_ACTIONS 16
+#define MAX_ENUM_VALUES 32
+
+typedef struct {
+    char *name;
+    char *desc;
+    char *type;
+    int required;
+    char **enum_values; /* NULL if not an enum */
+    int enum_count;
+} schema_prop_t;
+
+struct nebo_schema_builder {
+    char *actions[MAX_ACTIONS];
+    int action_count;
+    schema_prop_t props[MAX_PROPS];
+    int prop_count;
 };
 
 /**
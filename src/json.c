@@ -0,0 +1,736 @@
+/**
+ * Nebo C SDK — SIMD-accelerated JSON parser.
+ *
+ * Stage 1 classifies the input 64 bytes at a time into bitmasks (backslash,
+ * quote, structural operator, whitespace, control character), resolves
+ * escapes and string interiors with carry-propagating bit arithmetic, and
+ * emits the positions of operators, quotes and scalar starts. Only the
+ * classification differs between the AVX2, SSE4.2 and scalar paths; the bit
+ * logic is shared. Stage 2 is a goto state machine over those positions.
+ */
+
+#define _GNU_SOURCE /* strtod_l, newlocale */
+
+#include <locale.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nebo/json.h"
+#include "arena.h"
+#include "json_lex.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NEBO_JSON_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define ALWAYS_INLINE inline
+#endif
+
+#define MAX_DEPTH 1024
+#define TAPE_END 0xFF   /* closes the container opened at tape[idx].b */
+#define FLAG_KEY 0x01   /* string entry is an object key */
+
+typedef struct {
+    uint8_t type;  /* nebo_json_type_t or TAPE_END */
+    uint8_t flags;
+    uint32_t a;    /* string/number: offset in strings; container: index past its END */
+    uint32_t b;    /* string/number: length; container: element count */
+} tape_t;
+
+struct nebo_json_doc {
+    nebo_arena_t arena; /* owns this struct and everything it points to */
+    tape_t *tape;
+    size_t tape_len;
+    char *strings;      /* unescaped strings and number text, each NUL-terminated */
+};
+
+/* ── Stage 1: classification ─────────────────────────────────────────── */
+
+typedef struct {
+    uint64_t backslash;
+    uint64_t quote;
+    uint64_t op;    /* { } [ ] : , */
+    uint64_t ws;    /* space, \t, \n, \r */
+    uint64_t ctrl;  /* bytes < 0x20 */
+} masks_t;
+
+static ALWAYS_INLINE void classify_scalar(const uint8_t *in, masks_t *m) {
+    uint64_t bs = 0, quote = 0, op = 0, ws = 0, ctrl = 0;
+    for (int i = 0; i < 64; i++) {
+        uint8_t c = in[i];
+        uint64_t bit = 1ULL << i;
+        switch (c) {
+        case '\\': bs |= bit; break;
+        case '"':  quote |= bit; break;
+        case '{': case '}': case '[': case ']': case ':': case ',': op |= bit; break;
+        case ' ':  ws |= bit; break;
+        case '\t': case '\n': case '\r': ws |= bit; ctrl |= bit; break;
+        default:   if (c < 0x20) ctrl |= bit; break;
+        }
+    }
+    m->backslash = bs;
+    m->quote = quote;
+    m->op = op;
+    m->ws = ws;
+    m->ctrl = ctrl;
+}
+
+static ALWAYS_INLINE uint64_t prefix_xor_scalar(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+#ifdef NEBO_JSON_X86
+
+__attribute__((target("sse4.2")))
+static ALWAYS_INLINE uint64_t eq_sse(const __m128i v[4], char c) {
+    __m128i k = _mm_set1_epi8(c);
+    uint64_t r0 = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v[0], k));
+    uint64_t r1 = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v[1], k));
+    uint64_t r2 = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v[2], k));
+    uint64_t r3 = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v[3], k));
+    return r0 | (r1 << 16) | (r2 << 32) | (r3 << 48);
+}
+
+__attribute__((target("sse4.2")))
+static ALWAYS_INLINE void classify_sse42(const uint8_t *in, masks_t *m) {
+    __m128i v[4];
+    for (int i = 0; i < 4; i++) v[i] = _mm_loadu_si128((const __m128i *)(in + 16 * i));
+    m->backslash = eq_sse(v, '\\');
+    m->quote = eq_sse(v, '"');
+    m->op = eq_sse(v, '{') | eq_sse(v, '}') | eq_sse(v, '[') | eq_sse(v, ']') |
+            eq_sse(v, ':') | eq_sse(v, ',');
+    uint64_t tnr = eq_sse(v, '\t') | eq_sse(v, '\n') | eq_sse(v, '\r');
+    m->ws = eq_sse(v, ' ') | tnr;
+    /* Unsigned c < 0x20 is min(c, 0x1F) == c. */
+    __m128i lim = _mm_set1_epi8(0x1F);
+    uint64_t ctrl = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i lt = _mm_cmpeq_epi8(_mm_min_epu8(v[i], lim), v[i]);
+        ctrl |= (uint64_t)(uint32_t)_mm_movemask_epi8(lt) << (16 * i);
+    }
+    m->ctrl = ctrl;
+}
+
+__attribute__((target("avx2")))
+static ALWAYS_INLINE uint64_t eq_avx2(__m256i lo, __m256i hi, char c) {
+    __m256i k = _mm256_set1_epi8(c);
+    uint64_t l = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, k));
+    uint64_t h = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, k));
+    return l | (h << 32);
+}
+
+__attribute__((target("avx2")))
+static ALWAYS_INLINE void classify_avx2(const uint8_t *in, masks_t *m) {
+    __m256i lo = _mm256_loadu_si256((const __m256i *)in);
+    __m256i hi = _mm256_loadu_si256((const __m256i *)(in + 32));
+    m->backslash = eq_avx2(lo, hi, '\\');
+    m->quote = eq_avx2(lo, hi, '"');
+    m->op = eq_avx2(lo, hi, '{') | eq_avx2(lo, hi, '}') | eq_avx2(lo, hi, '[') |
+            eq_avx2(lo, hi, ']') | eq_avx2(lo, hi, ':') | eq_avx2(lo, hi, ',');
+    m->ws = eq_avx2(lo, hi, ' ') | eq_avx2(lo, hi, '\t') | eq_avx2(lo, hi, '\n') |
+            eq_avx2(lo, hi, '\r');
+    __m256i lim = _mm256_set1_epi8(0x1F);
+    uint64_t cl = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(lo, lim), lo));
+    uint64_t ch = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(hi, lim), hi));
+    m->ctrl = cl | (ch << 32);
+}
+
+/* Carry-less multiply by all ones is a prefix XOR in one instruction. */
+__attribute__((target("avx2,pclmul")))
+static ALWAYS_INLINE uint64_t prefix_xor_clmul(uint64_t x) {
+    __m128i all = _mm_set1_epi8((char)0xFF);
+    __m128i r = _mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)x), all, 0);
+    return (uint64_t)_mm_cvtsi128_si64(r);
+}
+
+#endif /* NEBO_JSON_X86 */
+
+/* ── Stage 1: structural index ───────────────────────────────────────── */
+
+typedef void (*classify_fn)(const uint8_t *in, masks_t *m);
+typedef uint64_t (*prefix_xor_fn)(uint64_t x);
+
+typedef struct {
+    uint64_t prev_escaped;   /* 1 if the next block's first byte is escaped */
+    uint64_t prev_in_string; /* all ones if the previous block ended inside a string */
+    uint64_t prev_scalar;    /* 1 if the previous block ended inside a scalar */
+    uint64_t bad_ctrl;       /* any control byte inside a string */
+} scan_t;
+
+static ALWAYS_INLINE int ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) { x >>= 1; n++; }
+    return n;
+#endif
+}
+
+#define ODD_BITS 0xAAAAAAAAAAAAAAAAULL
+
+/**
+ * Positions in one block that stage 2 must visit. Escape resolution follows
+ * the usual carry trick: a run of backslashes escapes the byte after it iff
+ * its length is odd, which falls out of one subtraction against ODD_BITS.
+ */
+static ALWAYS_INLINE uint64_t block_structurals(const masks_t *m, scan_t *s, prefix_xor_fn pxor) {
+    uint64_t escaped;
+    if (!m->backslash) {
+        escaped = s->prev_escaped;
+        s->prev_escaped = 0;
+    } else {
+        uint64_t potential = m->backslash & ~s->prev_escaped;
+        uint64_t maybe = potential << 1;
+        uint64_t code = ((maybe | ODD_BITS) - potential) ^ ODD_BITS;
+        escaped = code ^ (m->backslash | s->prev_escaped);
+        s->prev_escaped = (code & m->backslash) >> 63;
+    }
+
+    uint64_t quote = m->quote & ~escaped;
+    uint64_t in_string = pxor(quote) ^ s->prev_in_string;
+    s->prev_in_string = (uint64_t)((int64_t)in_string >> 63);
+    s->bad_ctrl |= m->ctrl & in_string;
+
+    uint64_t scalar = ~(m->op | m->ws | quote | in_string);
+    uint64_t scalar_start = scalar & ~((scalar << 1) | s->prev_scalar);
+    s->prev_scalar = scalar >> 63;
+
+    return (m->op & ~in_string) | quote | scalar_start;
+}
+
+static ALWAYS_INLINE size_t stage1_impl(const uint8_t *buf, size_t len, uint32_t *out,
+                                        scan_t *s, classify_fn classify, prefix_xor_fn pxor) {
+    size_t n = 0;
+    size_t pos = 0;
+    masks_t m;
+    for (; pos + 64 <= len; pos += 64) {
+        classify(buf + pos, &m);
+        uint64_t bits = block_structurals(&m, s, pxor);
+        while (bits) {
+            out[n++] = (uint32_t)(pos + ctz64(bits));
+            bits &= bits - 1;
+        }
+    }
+    if (pos < len) {
+        uint8_t tail[64];
+        memset(tail, ' ', sizeof(tail));
+        memcpy(tail, buf + pos, len - pos);
+        classify(tail, &m);
+        uint64_t bits = block_structurals(&m, s, pxor);
+        while (bits) {
+            out[n++] = (uint32_t)(pos + ctz64(bits));
+            bits &= bits - 1;
+        }
+    }
+    return n;
+}
+
+static size_t stage1_scalar(const uint8_t *buf, size_t len, uint32_t *out, scan_t *s) {
+    return stage1_impl(buf, len, out, s, classify_scalar, prefix_xor_scalar);
+}
+
+#ifdef NEBO_JSON_X86
+__attribute__((target("sse4.2,pclmul")))
+static size_t stage1_sse42(const uint8_t *buf, size_t len, uint32_t *out, scan_t *s) {
+    return stage1_impl(buf, len, out, s, classify_sse42, prefix_xor_scalar);
+}
+
+__attribute__((target("avx2,pclmul")))
+static size_t stage1_avx2(const uint8_t *buf, size_t len, uint32_t *out, scan_t *s) {
+    return stage1_impl(buf, len, out, s, classify_avx2, prefix_xor_clmul);
+}
+#endif
+
+typedef size_t (*stage1_fn)(const uint8_t *buf, size_t len, uint32_t *out, scan_t *s);
+
+typedef struct {
+    stage1_fn fn;
+    const char *name;
+} stage1_kernel_t;
+
+static const stage1_kernel_t k_scalar = {stage1_scalar, "scalar"};
+#ifdef NEBO_JSON_X86
+static const stage1_kernel_t k_sse42 = {stage1_sse42, "sse4.2"};
+static const stage1_kernel_t k_avx2 = {stage1_avx2, "avx2"};
+#endif
+
+/* Chosen once, by the first parse or by nebo_json_set_isa; read by every parse. */
+static _Atomic(const stage1_kernel_t *) g_kernel;
+
+static int isa_supported(nebo_json_isa_t isa) {
+    switch (isa) {
+    case NEBO_JSON_ISA_SCALAR:
+        return 1;
+#ifdef NEBO_JSON_X86
+    case NEBO_JSON_ISA_SSE42:
+        return __builtin_cpu_supports("sse4.2");
+    case NEBO_JSON_ISA_AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("pclmul");
+#endif
+    default:
+        return 0;
+    }
+}
+
+/* The kernel for isa, or NULL if the CPU lacks it. */
+static const stage1_kernel_t *kernel_for(nebo_json_isa_t isa) {
+    if (isa == NEBO_JSON_ISA_AUTO) {
+        isa = isa_supported(NEBO_JSON_ISA_AVX2)  ? NEBO_JSON_ISA_AVX2
+            : isa_supported(NEBO_JSON_ISA_SSE42) ? NEBO_JSON_ISA_SSE42
+            : NEBO_JSON_ISA_SCALAR;
+    }
+    if (!isa_supported(isa)) return NULL;
+    switch (isa) {
+#ifdef NEBO_JSON_X86
+    case NEBO_JSON_ISA_AVX2:  return &k_avx2;
+    case NEBO_JSON_ISA_SSE42: return &k_sse42;
+#endif
+    default:                  return &k_scalar;
+    }
+}
+
+/* The kernel in use, picking the best one on first use. */
+static const stage1_kernel_t *kernel(void) {
+    const stage1_kernel_t *k = atomic_load_explicit(&g_kernel, memory_order_acquire);
+    if (k) return k;
+    const stage1_kernel_t *best = kernel_for(NEBO_JSON_ISA_AUTO);
+    /* Racing first parses pick the same kernel; a concurrent set_isa wins. */
+    if (atomic_compare_exchange_strong_explicit(&g_kernel, &k, best, memory_order_acq_rel,
+                                                memory_order_acquire))
+        return best;
+    return k;
+}
+
+int nebo_json_set_isa(nebo_json_isa_t isa) {
+    const stage1_kernel_t *k = kernel_for(isa);
+    if (!k) return -1;
+    atomic_store_explicit(&g_kernel, k, memory_order_release);
+    return 0;
+}
+
+const char *nebo_json_isa_name(void) {
+    return kernel()->name;
+}
+
+/* ── Stage 2: tape ───────────────────────────────────────────────────── */
+
+typedef struct {
+    const uint8_t *buf;
+    size_t len;
+    char *err;
+    size_t errlen;
+    char *strings;
+    size_t str_len;
+} builder_t;
+
+static int json_fail(builder_t *b, size_t pos, const char *what) {
+    if (b->err && b->errlen) {
+        if (pos >= b->len) snprintf(b->err, b->errlen, "invalid JSON: %s at end of input", what);
+        else               snprintf(b->err, b->errlen, "invalid JSON: %s at offset %zu", what, pos);
+    }
+    return -1;
+}
+
+static int is_scalar_end(const builder_t *b, size_t pos) {
+    if (pos >= b->len) return 1;
+    switch (b->buf[pos]) {
+    case ' ': case '\t': case '\n': case '\r':
+    case '{': case '}': case '[': case ']': case ':': case ',': case '"':
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/* Copy the string between quotes at open and close into the string buffer. */
+static int emit_string(builder_t *b, tape_t *t, size_t open, size_t close, uint8_t flags) {
+    const uint8_t *s = b->buf + open + 1;
+    size_t raw = close - open - 1;
+    char *out = b->strings + b->str_len;
+    size_t n;
+    if (!memchr(s, '\\', raw)) {
+        memcpy(out, s, raw);
+        n = raw;
+    } else {
+        n = 0;
+        for (size_t i = 0; i < raw; i++) {
+            if (s[i] != '\\') {
+                out[n++] = (char)s[i];
+                continue;
+            }
+            /* Stage 1 guarantees a backslash inside a string is followed by a byte. */
+            switch (s[++i]) {
+            case '"':  out[n++] = '"'; break;
+            case '\\': out[n++] = '\\'; break;
+            case '/':  out[n++] = '/'; break;
+            case 'b':  out[n++] = '\b'; break;
+            case 'f':  out[n++] = '\f'; break;
+            case 'n':  out[n++] = '\n'; break;
+            case 'r':  out[n++] = '\r'; break;
+            case 't':  out[n++] = '\t'; break;
+            case 'u': {
+                unsigned cp, lo;
+                if (i + 4 >= raw || nebo_json_hex4((const char *)s + i + 1, &cp) != 0)
+                    return json_fail(b, open + 1 + i, "bad \\u escape");
+                i += 4;
+                if (cp >= 0xD800 && cp <= 0xDBFF && i + 6 < raw &&
+                    s[i + 1] == '\\' && s[i + 2] == 'u' && nebo_json_hex4((const char *)s + i + 3, &lo) == 0 &&
+                    lo >= 0xDC00 && lo <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    i += 6;
+                }
+                n += nebo_json_put_utf8(out + n, cp);
+                break;
+            }
+            default:
+                return json_fail(b, open + 1 + i, "bad escape");
+            }
+        }
+    }
+    out[n] = '\0';
+    t->flags = flags;
+    t->a = (uint32_t)b->str_len;
+    t->b = (uint32_t)n;
+    b->str_len += n + 1;
+    return 0;
+}
+
+static int emit_number(builder_t *b, tape_t *t, size_t pos) {
+    const char *p = (const char *)b->buf + pos;
+    const char *digits = p + (*p == '-');
+    const char *stop;
+    if (nebo_json_scan_number(p, (const char *)b->buf + b->len, &stop) != 0)
+        return json_fail(b, pos, stop == digits && stop < (const char *)b->buf + b->len
+                                     ? "unexpected character" : "bad number");
+    size_t n = (size_t)(stop - p);
+    if (!is_scalar_end(b, pos + n)) return json_fail(b, pos, "bad number");
+    memcpy(b->strings + b->str_len, p, n);
+    b->strings[b->str_len + n] = '\0';
+    t->type = NEBO_JSON_NUMBER;
+    t->a = (uint32_t)b->str_len;
+    t->b = (uint32_t)n;
+    b->str_len += n + 1;
+    return 0;
+}
+
+static int emit_literal(builder_t *b, tape_t *t, size_t pos) {
+    static const struct { const char *text; size_t len; uint8_t type; } lits[] = {
+        {"true", 4, NEBO_JSON_TRUE}, {"false", 5, NEBO_JSON_FALSE}, {"null", 4, NEBO_JSON_NULL},
+    };
+    for (size_t i = 0; i < sizeof(lits) / sizeof(lits[0]); i++) {
+        if (b->len - pos >= lits[i].len && memcmp(b->buf + pos, lits[i].text, lits[i].len) == 0 &&
+            is_scalar_end(b, pos + lits[i].len)) {
+            t->type = lits[i].type;
+            return 0;
+        }
+    }
+    return json_fail(b, pos, "unexpected character");
+}
+
+typedef struct {
+    uint32_t open; /* tape index of the container */
+    uint32_t count;
+} frame_t;
+
+/* Builds the tape from the structural index. Returns the tape length or -1. */
+static long stage2(builder_t *b, const uint32_t *idx, size_t n, tape_t *tape, frame_t *stack) {
+    size_t si = 0, tl = 0;
+    int depth = 0;
+    size_t pos;
+
+#define NEXT()                                                                     \
+    do {                                                                           \
+        if (si >= n) return json_fail(b, b->len, "unexpected end");                \
+        pos = idx[si++];                                                           \
+    } while (0)
+
+value:
+    NEXT();
+    switch (b->buf[pos]) {
+    case '{':
+        if (depth == MAX_DEPTH) return json_fail(b, pos, "nesting too deep");
+        tape[tl] = (tape_t){NEBO_JSON_OBJECT, 0, 0, 0};
+        stack[depth++] = (frame_t){(uint32_t)tl++, 0};
+        NEXT();
+        if (b->buf[pos] == '}') goto close;
+        goto key_at_pos;
+    case '[':
+        if (depth == MAX_DEPTH) return json_fail(b, pos, "nesting too deep");
+        tape[tl] = (tape_t){NEBO_JSON_ARRAY, 0, 0, 0};
+        stack[depth++] = (frame_t){(uint32_t)tl++, 0};
+        if (si < n && b->buf[idx[si]] == ']') {
+            NEXT();
+            goto close;
+        }
+        stack[depth - 1].count++;
+        goto value;
+    case '"': {
+        size_t open = pos;
+        NEXT(); /* stage 1 pairs every opening quote with its closing one */
+        tape[tl].type = NEBO_JSON_STRING;
+        if (emit_string(b, &tape[tl], open, pos, 0) != 0) return -1;
+        tl++;
+        goto after;
+    }
+    case 't': case 'f': case 'n':
+        if (emit_literal(b, &tape[tl], pos) != 0) return -1;
+        tape[tl].flags = 0;
+        tl++;
+        goto after;
+    default:
+        if (emit_number(b, &tape[tl], pos) != 0) return -1;
+        tape[tl].flags = 0;
+        tl++;
+        goto after;
+    }
+
+key:
+    NEXT();
+key_at_pos:
+    if (b->buf[pos] != '"') return json_fail(b, pos, "expected object key");
+    {
+        size_t open = pos;
+        NEXT();
+        tape[tl].type = NEBO_JSON_STRING;
+        if (emit_string(b, &tape[tl], open, pos, FLAG_KEY) != 0) return -1;
+        tl++;
+    }
+    stack[depth - 1].count++;
+    NEXT();
+    if (b->buf[pos] != ':') return json_fail(b, pos, "expected ':'");
+    goto value;
+
+after:
+    if (depth == 0) {
+        if (si != n) return json_fail(b, idx[si], "trailing characters");
+        return (long)tl;
+    }
+    NEXT();
+    if (tape[stack[depth - 1].open].type == NEBO_JSON_OBJECT) {
+        if (b->buf[pos] == ',') goto key;
+        if (b->buf[pos] == '}') goto close;
+        return json_fail(b, pos, "expected ',' or '}'");
+    }
+    if (b->buf[pos] == ',') {
+        stack[depth - 1].count++;
+        goto value;
+    }
+    if (b->buf[pos] == ']') goto close;
+    return json_fail(b, pos, "expected ',' or ']'");
+
+close:
+    {
+        frame_t f = stack[--depth];
+        tape[tl] = (tape_t){TAPE_END, 0, 0, f.open};
+        tl++;
+        tape[f.open].a = (uint32_t)tl;
+        tape[f.open].b = f.count;
+    }
+    goto after;
+#undef NEXT
+}
+
+nebo_json_doc_t *nebo_json_parse(const char *json, size_t len, char *err, size_t errlen) {
+    if (err && errlen) err[0] = '\0';
+    if (!json) return NULL;
+    builder_t b = {(const uint8_t *)json, len, err, errlen, NULL, 0};
+    if (len >= UINT32_MAX) {
+        json_fail(&b, 0, "document larger than 4 GiB");
+        return NULL;
+    }
+
+    /* Scratch for the structural index; the document keeps its own arena. */
+    uint32_t *idx = malloc((len + 1) * sizeof(uint32_t));
+    if (!idx) return NULL;
+    scan_t scan = {0, 0, 0, 0};
+    size_t n = kernel()->fn((const uint8_t *)json, len, idx, &scan);
+    if (scan.prev_in_string) {
+        json_fail(&b, len, "unterminated string");
+        free(idx);
+        return NULL;
+    }
+    if (scan.bad_ctrl) {
+        json_fail(&b, 0, "control character in string");
+        free(idx);
+        return NULL;
+    }
+    if (n == 0) {
+        json_fail(&b, len, "empty input");
+        free(idx);
+        return NULL;
+    }
+
+    /* Each value takes at most one tape entry per structural position, and
+     * unescaped text plus one NUL per value never exceeds len + n. */
+    size_t depth = n < MAX_DEPTH ? n : MAX_DEPTH;
+    nebo_arena_t a;
+    nebo_arena_init(&a, sizeof(nebo_json_doc_t) + n * sizeof(tape_t) + len + n + 64);
+    nebo_json_doc_t *doc = nebo_arena_alloc(&a, sizeof(nebo_json_doc_t));
+    tape_t *tape = nebo_arena_alloc(&a, n * sizeof(tape_t));
+    char *strings = nebo_arena_alloc(&a, len + n + 1);
+    frame_t *stack = malloc(depth * sizeof(frame_t));
+    if (!doc || !tape || !strings || !stack) {
+        free(stack);
+        free(idx);
+        nebo_arena_free(&a);
+        return NULL;
+    }
+    b.strings = strings;
+    long tl = stage2(&b, idx, n, tape, stack);
+    free(stack);
+    free(idx);
+    if (tl < 0) {
+        nebo_arena_free(&a);
+        return NULL;
+    }
+    doc->tape = tape;
+    doc->tape_len = (size_t)tl;
+    doc->strings = strings;
+    doc->arena = a;
+    return doc;
+}
+
+void nebo_json_free(nebo_json_doc_t *doc) {
+    if (!doc) return;
+    nebo_arena_t a = doc->arena;
+    nebo_arena_free(&a);
+}
+
+/* ── Accessors ───────────────────────────────────────────────────────── */
+
+static const nebo_json_t INVALID = {NULL, 0};
+
+static const tape_t *entry(nebo_json_t v) {
+    return v.doc && v.idx < v.doc->tape_len ? &v.doc->tape[v.idx] : NULL;
+}
+
+/* Index just past v (past its END for containers). */
+static size_t after(const nebo_json_doc_t *doc, size_t i) {
+    uint8_t t = doc->tape[i].type;
+    return t == NEBO_JSON_OBJECT || t == NEBO_JSON_ARRAY ? doc->tape[i].a : i + 1;
+}
+
+nebo_json_t nebo_json_root(const nebo_json_doc_t *doc) {
+    nebo_json_t v = {doc, 0};
+    return doc ? v : INVALID;
+}
+
+/* Created on first use; newlocale("C") is cheap but not free. */
+static _Atomic(locale_t) g_c_locale;
+
+double nebo_json_strtod(const char *s) {
+    locale_t loc = atomic_load_explicit(&g_c_locale, memory_order_acquire);
+    if (!loc) {
+        locale_t fresh = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+        if (!fresh) return strtod(s, NULL); /* out of memory */
+        locale_t expected = (locale_t)0;
+        if (atomic_compare_exchange_strong(&g_c_locale, &expected, fresh)) {
+            loc = fresh;
+        } else {
+            freelocale(fresh);
+            loc = expected;
+        }
+    }
+    return strtod_l(s, NULL, loc);
+}
+
+nebo_json_type_t nebo_json_type(nebo_json_t v) {
+    const tape_t *t = entry(v);
+    return t && t->type != TAPE_END ? (nebo_json_type_t)t->type : NEBO_JSON_INVALID;
+}
+
+double nebo_json_number(nebo_json_t v) {
+    const tape_t *t = entry(v);
+    if (!t || t->type != NEBO_JSON_NUMBER) return 0;
+    return nebo_json_strtod(v.doc->strings + t->a);
+}
+
+const char *nebo_json_number_text(nebo_json_t v, size_t *len) {
+    const tape_t *t = entry(v);
+    if (!t || t->type != NEBO_JSON_NUMBER) return NULL;
+    if (len) *len = t->b;
+    return v.doc->strings + t->a;
+}
+
+const char *nebo_json_string(nebo_json_t v, size_t *len) {
+    const tape_t *t = entry(v);
+    if (!t || t->type != NEBO_JSON_STRING) {
+        if (len) *len = 0;
+        return NULL;
+    }
+    if (len) *len = t->b;
+    return v.doc->strings + t->a;
+}
+
+int nebo_json_bool(nebo_json_t v) {
+    const tape_t *t = entry(v);
+    return t && t->type == NEBO_JSON_TRUE;
+}
+
+size_t nebo_json_size(nebo_json_t v) {
+    const tape_t *t = entry(v);
+    return t && (t->type == NEBO_JSON_OBJECT || t->type == NEBO_JSON_ARRAY) ? t->b : 0;
+}
+
+nebo_json_t nebo_json_first(nebo_json_t c) {
+    const tape_t *t = entry(c);
+    if (!t || (t->type != NEBO_JSON_OBJECT && t->type != NEBO_JSON_ARRAY) || t->b == 0)
+        return INVALID;
+    nebo_json_t v = {c.doc, c.idx + 1};
+    if (t->type == NEBO_JSON_OBJECT) v.idx++; /* skip the key */
+    return v;
+}
+
+nebo_json_t nebo_json_next(nebo_json_t v) {
+    if (!entry(v)) return INVALID;
+    size_t j = after(v.doc, v.idx);
+    if (j >= v.doc->tape_len || v.doc->tape[j].type == TAPE_END) return INVALID;
+    if (v.doc->tape[j].flags & FLAG_KEY) j++;
+    nebo_json_t n = {v.doc, j};
+    return n;
+}
+
+const char *nebo_json_key(nebo_json_t v, size_t *len) {
+    if (!entry(v) || v.idx == 0 || !(v.doc->tape[v.idx - 1].flags & FLAG_KEY)) {
+        if (len) *len = 0;
+        return NULL;
+    }
+    const tape_t *k = &v.doc->tape[v.idx - 1];
+    if (len) *len = k->b;
+    return v.doc->strings + k->a;
+}
+
+nebo_json_t nebo_json_get(nebo_json_t obj, const char *key) {
+    if (nebo_json_type(obj) != NEBO_JSON_OBJECT || !key) return INVALID;
+    size_t klen = strlen(key);
+    for (nebo_json_t m = nebo_json_first(obj); m.doc; m = nebo_json_next(m)) {
+        const tape_t *k = &m.doc->tape[m.idx - 1];
+        if (k->b == klen && memcmp(m.doc->strings + k->a, key, klen) == 0) return m;
+    }
+    return INVALID;
+}
+
+nebo_json_t nebo_json_at(nebo_json_t arr, size_t i) {
+    if (nebo_json_type(arr) != NEBO_JSON_ARRAY) return INVALID;
+    nebo_json_t e = nebo_json_first(arr);
+    while (e.doc && i--) e = nebo_json_next(e);
+    return e;
+}
@@ -0,0 +1,108 @@
+#ifndef NEBO_JSON_LEX_H
+#define NEBO_JSON_LEX_H
+
+#include <stddef.h>
+
+#include "nebo/json.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Lexical pieces shared by the tape parser (json.c) and the schema
+ * validator (input.c), so the two accept exactly the same strings and
+ * numbers, plus the locale-free number reads the rest of the SDK uses.
+ */
+
+/** Decode four hex digits at s. Returns 0, or -1 if one is not hex. */
+static inline int nebo_json_hex4(const char *s, unsigned *out) {
+    unsigned v = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = s[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9')      v |= (unsigned)(c - '0');
+        else if (c >= 'a' && c <= 'f') v |= (unsigned)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') v |= (unsigned)(c - 'A' + 10);
+        else return -1;
+    }
+    *out = v;
+    return 0;
+}
+
+/** Encode cp as UTF-8 at out (room for 4 bytes). Returns the byte count. */
+static inline size_t nebo_json_put_utf8(char *out, unsigned cp) {
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (cp >> 18));
+    out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+/**
+ * Match the JSON number grammar at p, reading no further than end. Returns
+ * 0 with *stop just past the number, or -1 with *stop on the offending
+ * byte (end if the input ran out).
+ */
+static inline int nebo_json_scan_number(const char *p, const char *end, const char **stop) {
+    const char *q = p;
+    if (q < end && *q == '-') q++;
+    if (q >= end) goto bad;
+    if (*q == '0') {
+        q++;
+    } else if (*q >= '1' && *q <= '9') {
+        while (q < end && *q >= '0' && *q <= '9') q++;
+    } else {
+        goto bad;
+    }
+    if (q < end && *q == '.') {
+        q++;
+        if (q >= end || *q < '0' || *q > '9') goto bad;
+        while (q < end && *q >= '0' && *q <= '9') q++;
+    }
+    if (q < end && (*q == 'e' || *q == 'E')) {
+        q++;
+        if (q < end && (*q == '+' || *q == '-')) q++;
+        if (q >= end || *q < '0' || *q > '9') goto bad;
+        while (q < end && *q >= '0' && *q <= '9') q++;
+    }
+    *stop = q;
+    return 0;
+bad:
+    *stop = q;
+    return -1;
+}
+
+/**
+ * strtod for the NUL-terminated number text at s, always in the C locale:
+ * the process locale may use ',' as the decimal point, JSON never does.
+ * Implemented in json.c.
+ */
+double nebo_json_strtod(const char *s);
+
+/**
+ * The number as written in the input, for callers that must not lose
+ * digits to a double; NULL if v is not a number. Implemented in json.c.
+ */
+const char *nebo_json_number_text(nebo_json_t v, size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NEBO_JSON_LEX_H */
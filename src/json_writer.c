@@ -0,0 +1,623 @@
+/**
+ * Nebo C SDK — streaming JSON writer.
+ *
+ * Everything is appended to one contiguous buffer that grows geometrically,
+ * so a finished document is handed over as-is: as the malloc'd string an
+ * execute handler returns, or already in place in an ExecuteResponse when
+ * the buffer belongs to a nebo_tool_output_json() sink.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "json_lex.h"
+#include "json_writer.h"
+
+#define DEFAULT_CAPACITY 256
+#define FRAME_OBJECT   0x01
+#define FRAME_NONEMPTY 0x02
+
+/* ── Buffer ──────────────────────────────────────────────────────────── */
+
+static int heap_grow(nebo_json_writer_t *w, size_t need) {
+    size_t cap = w->cap ? w->cap * 2 : DEFAULT_CAPACITY;
+    while (cap - w->len < need) cap *= 2;
+    char *buf = realloc(w->buf, cap + 1); /* + NUL */
+    if (!buf) return -1;
+    w->buf = buf;
+    w->cap = cap;
+    return 0;
+}
+
+static int fail(nebo_json_writer_t *w) {
+    w->failed = 1;
+    return 0;
+}
+
+/** Make room for n more bytes. Returns 0 (and fails the writer) on OOM. */
+static inline int reserve(nebo_json_writer_t *w, size_t n) {
+    if (w->cap - w->len >= n) return 1;
+    int ret = w->sink.grow ? w->sink.grow(w, n) : heap_grow(w, n);
+    return ret == 0 ? 1 : fail(w);
+}
+
+static inline void put(nebo_json_writer_t *w, const char *s, size_t n) {
+    if (!reserve(w, n)) return;
+    memcpy(w->buf + w->len, s, n);
+    w->len += n;
+}
+
+static inline void put_char(nebo_json_writer_t *w, char c) {
+    if (!reserve(w, 1)) return;
+    w->buf[w->len++] = c;
+}
+
+/* ── Structure ───────────────────────────────────────────────────────── */
+
+/** Separator and placement checks before any value. Returns 0 to skip it. */
+static int begin_value(nebo_json_writer_t *w) {
+    if (w->failed) return 0;
+    if (w->depth == 0) return w->done ? fail(w) : 1;
+    unsigned char *top = &w->frames[w->depth - 1];
+    if (*top & FRAME_OBJECT) {
+        if (!w->want_value) return fail(w);
+        w->want_value = 0;
+        return 1;
+    }
+    if (*top & FRAME_NONEMPTY) put_char(w, ',');
+    *top |= FRAME_NONEMPTY;
+    return !w->failed;
+}
+
+static void end_value(nebo_json_writer_t *w) {
+    if (w->depth == 0) w->done = 1;
+}
+
+static void open_container(nebo_json_writer_t *w, char c, unsigned char frame) {
+    if (!w || !begin_value(w)) return;
+    if (w->depth == NEBO_JSON_WRITER_MAX_DEPTH) {
+        fail(w);
+        return;
+    }
+    put_char(w, c);
+    w->frames[w->depth++] = frame;
+}
+
+static void close_container(nebo_json_writer_t *w, char c, unsigned char frame) {
+    if (!w || w->failed) return;
+    if (w->depth == 0 || (w->frames[w->depth - 1] & FRAME_OBJECT) != frame || w->want_value) {
+        fail(w);
+        return;
+    }
+    put_char(w, c);
+    w->depth--;
+    end_value(w);
+}
+
+void nebo_json_write_begin_object(nebo_json_writer_t *w) { open_container(w, '{', FRAME_OBJECT); }
+void nebo_json_write_end_object(nebo_json_writer_t *w) { close_container(w, '}', FRAME_OBJECT); }
+void nebo_json_write_begin_array(nebo_json_writer_t *w) { open_container(w, '[', 0); }
+void nebo_json_write_end_array(nebo_json_writer_t *w) { close_container(w, ']', 0); }
+
+/* ── Strings ─────────────────────────────────────────────────────────── */
+
+#define ONES  0x0101010101010101ULL
+#define HIGHS 0x8080808080808080ULL
+
+/** Length of the prefix that needs no escaping: no control byte, '"' or '\'. */
+static size_t clean_run(const unsigned char *p, size_t n) {
+    size_t i = 0;
+    /* Eight bytes at a time; the exact position is found bytewise below. */
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x;
+        memcpy(&x, p + i, 8);
+        uint64_t q = x ^ (ONES * '"');
+        uint64_t b = x ^ (ONES * '\\');
+        uint64_t hit = ((x - ONES * 0x20) & ~x) | ((q - ONES) & ~q) | ((b - ONES) & ~b);
+        if (hit & HIGHS) break;
+    }
+    while (i < n && p[i] >= 0x20 && p[i] != '"' && p[i] != '\\') i++;
+    return i;
+}
+
+static void put_string(nebo_json_writer_t *w, const char *s, size_t n) {
+    static const char hex[] = "0123456789abcdef";
+    const unsigned char *p = (const unsigned char *)s;
+    if (!reserve(w, n + 2)) return;
+    w->buf[w->len++] = '"';
+    size_t i = 0;
+    for (;;) {
+        size_t run = clean_run(p + i, n - i);
+        memcpy(w->buf + w->len, p + i, run);
+        w->len += run;
+        i += run;
+        if (i == n) break;
+        /* Up to 6 bytes for this escape plus the rest and the closing quote. */
+        if (!reserve(w, 6 + (n - i))) return;
+        char *o = w->buf + w->len;
+        unsigned char c = p[i++];
+        *o++ = '\\';
+        switch (c) {
+        case '"':  *o++ = '"'; break;
+        case '\\': *o++ = '\\'; break;
+        case '\b': *o++ = 'b'; break;
+        case '\f': *o++ = 'f'; break;
+        case '\n': *o++ = 'n'; break;
+        case '\r': *o++ = 'r'; break;
+        case '\t': *o++ = 't'; break;
+        default:
+            memcpy(o, "u00", 3);
+            o[3] = hex[c >> 4];
+            o[4] = hex[c & 0xF];
+            o += 5;
+            break;
+        }
+        w->len = (size_t)(o - w->buf);
+    }
+    w->buf[w->len++] = '"';
+}
+
+void nebo_json_write_keyn(nebo_json_writer_t *w, const char *key, size_t len) {
+    if (!w || w->failed) return;
+    if (w->depth == 0 || !(w->frames[w->depth - 1] & FRAME_OBJECT) || w->want_value || !key) {
+        fail(w);
+        return;
+    }
+    unsigned char *top = &w->frames[w->depth - 1];
+    if (*top & FRAME_NONEMPTY) put_char(w, ',');
+    *top |= FRAME_NONEMPTY;
+    put_string(w, key, len);
+    put_char(w, ':');
+    w->want_value = 1;
+}
+
+void nebo_json_write_key(nebo_json_writer_t *w, const char *key) {
+    nebo_json_write_keyn(w, key, key ? strlen(key) : 0);
+}
+
+void nebo_json_write_stringn(nebo_json_writer_t *w, const char *s, size_t len) {
+    if (!s) {
+        nebo_json_write_null(w);
+        return;
+    }
+    if (!w || !begin_value(w)) return;
+    put_string(w, s, len);
+    end_value(w);
+}
+
+void nebo_json_write_string(nebo_json_writer_t *w, const char *s) {
+    nebo_json_write_stringn(w, s, s ? strlen(s) : 0);
+}
+
+/* ── Numbers ─────────────────────────────────────────────────────────── */
+
+static const char digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/** Write v's digits ending just before end; returns the first digit. */
+static char *format_u64(char *end, uint64_t v) {
+    while (v >= 100) {
+        unsigned d = (unsigned)(v % 100) * 2;
+        v /= 100;
+        *--end = digit_pairs[d + 1];
+        *--end = digit_pairs[d];
+    }
+    if (v >= 10) {
+        *--end = digit_pairs[v * 2 + 1];
+        *--end = digit_pairs[v * 2];
+    } else {
+        *--end = (char)('0' + v);
+    }
+    return end;
+}
+
+/*
+ * Shortest round-trip doubles: Grisu3 (Loitsch, "Printing Floating-Point
+ * Numbers Quickly and Accurately with Integers", PLDI 2010). The value and
+ * its rounding boundaries are scaled by a cached power of ten into 64-bit
+ * fixed point, and digits are generated until they fall inside the
+ * boundaries. For under one value in a hundred the fixed-point error
+ * leaves the result unsure; Grisu3 detects it, and those values take the
+ * exact path below instead.
+ */
+
+typedef struct {
+    uint64_t f;
+    int e;
+} diyfp_t;
+
+#define DP_SIGNIFICAND_MASK 0x000FFFFFFFFFFFFFULL
+#define DP_HIDDEN_BIT       0x0010000000000000ULL
+#define DP_EXPONENT_BIAS    (0x3FF + 52)
+
+static diyfp_t diyfp_mul(diyfp_t x, diyfp_t y) {
+    const uint64_t M32 = 0xFFFFFFFFu;
+    uint64_t a = x.f >> 32, b = x.f & M32, c = y.f >> 32, d = y.f & M32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t mid = (bd >> 32) + (ad & M32) + (bc & M32) + (1ULL << 31); /* round */
+    diyfp_t r = {ac + (ad >> 32) + (bc >> 32) + (mid >> 32), x.e + y.e + 64};
+    return r;
+}
+
+static diyfp_t diyfp_normalize(diyfp_t x) {
+    while (!(x.f & (1ULL << 63))) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+/* Normalized 10^k for k = -348, -340, ..., 340. */
+static const uint64_t cached_powers_f[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+
+static const int16_t cached_powers_e[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static diyfp_t cached_power(int e, int *k) {
+    /* Smallest power whose product with a 2^e value has exponent >= -60. */
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int ik = (int)dk;
+    if (dk - ik > 0.0) ik++;
+    unsigned idx = (unsigned)((ik >> 3) + 1);
+    *k = -(-348 + (int)idx * 8);
+    diyfp_t r = {cached_powers_f[idx], cached_powers_e[idx]};
+    return r;
+}
+
+static const uint64_t pow10_u64[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+/**
+ * Move the last digit toward w while staying inside the unsafe interval.
+ * Returns 0 if the fixed-point error leaves the closest or the
+ * in-range choice undecided.
+ */
+static int round_weed(char *buf, int len, uint64_t too_high_w, uint64_t unsafe,
+                      uint64_t rest, uint64_t ten_kappa, uint64_t unit) {
+    uint64_t small = too_high_w - unit;
+    uint64_t big = too_high_w + unit;
+    while (rest < small && unsafe - rest >= ten_kappa &&
+           (rest + ten_kappa < small || small - rest >= rest + ten_kappa - small)) {
+        buf[len - 1]--;
+        rest += ten_kappa;
+    }
+    if (rest < big && unsafe - rest >= ten_kappa &&
+        (rest + ten_kappa < big || big - rest > rest + ten_kappa - big))
+        return 0;
+    return 2 * unit <= rest && rest <= unsafe - 4 * unit;
+}
+
+/** Shortest digits inside (low, high) for w. Returns the count, 0 if unsure. */
+static int digit_gen(diyfp_t low, diyfp_t w, diyfp_t high, char *buf, int *k) {
+    uint64_t unit = 1;
+    uint64_t too_high = high.f + unit;
+    uint64_t unsafe = too_high - (low.f - unit);
+    int shift = -w.e;
+    uint64_t one = 1ULL << shift;
+    uint32_t p1 = (uint32_t)(too_high >> shift);
+    uint64_t p2 = too_high & (one - 1);
+    int kappa = 0;
+    while (kappa < 10 && p1 >= pow10_u64[kappa]) kappa++;
+    int len = 0;
+    while (kappa > 0) {
+        uint32_t div = (uint32_t)pow10_u64[kappa - 1];
+        buf[len++] = (char)('0' + p1 / div);
+        p1 %= div;
+        kappa--;
+        uint64_t rest = ((uint64_t)p1 << shift) + p2;
+        if (rest < unsafe) {
+            *k += kappa;
+            return round_weed(buf, len, too_high - w.f, unsafe, rest,
+                              (uint64_t)div << shift, unit) ? len : 0;
+        }
+    }
+    for (;;) {
+        p2 *= 10;
+        unit *= 10;
+        unsafe *= 10;
+        buf[len++] = (char)('0' + (p2 >> shift));
+        p2 &= one - 1;
+        kappa--;
+        if (p2 < unsafe) {
+            *k += kappa;
+            return round_weed(buf, len, (too_high - w.f) * unit, unsafe, p2, one, unit) ? len : 0;
+        }
+    }
+}
+
+/**
+ * Digits of a positive finite v into buf; v == digits * 10^k. Returns the
+ * count, or 0 when Grisu3 cannot be sure they are the shortest.
+ */
+static int grisu3(double v, char *buf, int *k) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    int biased = (int)((bits >> 52) & 0x7FF);
+    diyfp_t x;
+    if (biased) {
+        x.f = (bits & DP_SIGNIFICAND_MASK) + DP_HIDDEN_BIT;
+        x.e = biased - DP_EXPONENT_BIAS;
+    } else {
+        x.f = bits & DP_SIGNIFICAND_MASK;
+        x.e = 1 - DP_EXPONENT_BIAS;
+    }
+
+    /* Boundaries halfway to the neighbouring doubles, on w's exponent. */
+    diyfp_t plus = diyfp_normalize((diyfp_t){(x.f << 1) + 1, x.e - 1});
+    diyfp_t minus = x.f == DP_HIDDEN_BIT && biased > 1
+                        ? (diyfp_t){(x.f << 2) - 1, x.e - 2}
+                        : (diyfp_t){(x.f << 1) - 1, x.e - 1};
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    diyfp_t c = cached_power(plus.e, k);
+    return digit_gen(diyfp_mul(minus, c), diyfp_mul(diyfp_normalize(x), c),
+                     diyfp_mul(plus, c), buf, k);
+}
+
+/**
+ * The exact path: the fewest significant digits, correctly rounded by
+ * printf, that read back to v. Only the digits and exponent of printf's
+ * output are used, so its locale does not matter.
+ */
+static int shortest_exact(double v, char *buf, int *k) {
+    for (int prec = 1; prec <= 17; prec++) {
+        char tmp[40];
+        snprintf(tmp, sizeof(tmp), "%.*e", prec - 1, v);
+        int n = 0;
+        const char *p = tmp;
+        for (; *p && *p != 'e'; p++)
+            if (*p >= '0' && *p <= '9') buf[n++] = *p;
+        int exp = atoi(p + 1);
+        char back[48];
+        memcpy(back, buf, 1);
+        back[1] = '.';
+        memcpy(back + 2, buf + 1, n - 1);
+        snprintf(back + n + 1, sizeof(back) - (size_t)n - 1, "e%d", exp);
+        if (nebo_json_strtod(back) != v) continue;
+        while (n > 1 && buf[n - 1] == '0') n--;
+        *k = exp - n + 1;
+        return n;
+    }
+    return 0; /* not reached: 17 digits always round-trip */
+}
+
+static const double pow10_f64[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8};
+
+/**
+ * Digits of a positive v that is exactly m / 10^j for a small j, the shape
+ * of most values handlers emit (counts, prices, percentages). Cheaper than
+ * grisu3() and never falls back to the exact path.
+ * Returns 0 if v is not of that shape.
+ */
+static int exact_decimal(double v, char *buf, int *k) {
+    if (v >= 1e15 || v < 1e-8) return 0;
+    for (int j = 0; j < (int)(sizeof(pow10_f64) / sizeof(pow10_f64[0])); j++) {
+        double s = v * pow10_f64[j];
+        /* Past 15 digits a shorter decimal may also read back to v. */
+        if (s >= 1e15) return 0;
+        uint64_t m = (uint64_t)s;
+        if ((double)m != s || s / pow10_f64[j] != v) continue;
+        while (j > 0 && m % 10 == 0) {
+            m /= 10;
+            j--;
+        }
+        char tmp[20];
+        char *end = tmp + sizeof(tmp);
+        char *d = format_u64(end, m);
+        int n = (int)(end - d);
+        memcpy(buf, d, n);
+        *k = -j;
+        return n;
+    }
+    return 0;
+}
+
+/**
+ * Format a finite double in the shortest form that reads back to the same
+ * value, the way JavaScript prints numbers: plain notation for magnitudes
+ * in [1e-6, 1e21), exponent notation outside. Returns the length written
+ * to out (>= 32 bytes), NUL-terminated.
+ */
+static size_t format_double(char *out, double v) {
+    char *o = out;
+    if (signbit(v)) *o++ = '-';
+    if (v == 0) {
+        *o++ = '0';
+        *o = '\0';
+        return (size_t)(o - out);
+    }
+    char d[20];
+    int k = 0;
+    int n = exact_decimal(fabs(v), d, &k);
+    if (!n) n = grisu3(fabs(v), d, &k);
+    if (!n) n = shortest_exact(fabs(v), d, &k);
+    int kk = n + k; /* 10^(kk-1) <= |v| < 10^kk */
+    if (k >= 0 && kk <= 21) {
+        /* 1234e3 -> 1234000 */
+        memcpy(o, d, n);
+        memset(o + n, '0', k);
+        o += kk;
+    } else if (kk > 0 && kk <= 21) {
+        /* 1234e-2 -> 12.34 */
+        memcpy(o, d, kk);
+        o[kk] = '.';
+        memcpy(o + kk + 1, d + kk, n - kk);
+        o += n + 1;
+    } else if (kk > -6 && kk <= 0) {
+        /* 1234e-6 -> 0.001234 */
+        *o++ = '0';
+        *o++ = '.';
+        memset(o, '0', -kk);
+        o += -kk;
+        memcpy(o, d, n);
+        o += n;
+    } else {
+        /* 1234e30 -> 1.234e33 */
+        *o++ = d[0];
+        if (n > 1) {
+            *o++ = '.';
+            memcpy(o, d + 1, n - 1);
+            o += n - 1;
+        }
+        *o++ = 'e';
+        int exp = kk - 1;
+        if (exp < 0) {
+            *o++ = '-';
+            exp = -exp;
+        }
+        char tmp[8];
+        char *end = tmp + sizeof(tmp);
+        char *e = format_u64(end, (uint64_t)exp);
+        memcpy(o, e, (size_t)(end - e));
+        o += end - e;
+    }
+    *o = '\0';
+    return (size_t)(o - out);
+}
+
+void nebo_json_write_number(nebo_json_writer_t *w, double v) {
+    if (!isfinite(v)) {
+        nebo_json_write_null(w);
+        return;
+    }
+    if (!w || !begin_value(w)) return;
+    char tmp[32];
+    put(w, tmp, format_double(tmp, v));
+    end_value(w);
+}
+
+void nebo_json_write_int(nebo_json_writer_t *w, long long v) {
+    if (!w || !begin_value(w)) return;
+    char tmp[24];
+    char *end = tmp + sizeof(tmp);
+    char *d = format_u64(end, v < 0 ? 0 - (uint64_t)v : (uint64_t)v);
+    if (v < 0) *--d = '-';
+    put(w, d, (size_t)(end - d));
+    end_value(w);
+}
+
+/* ── Literals ────────────────────────────────────────────────────────── */
+
+void nebo_json_write_bool(nebo_json_writer_t *w, int v) {
+    if (!w || !begin_value(w)) return;
+    if (v) put(w, "true", 4);
+    else put(w, "false", 5);
+    end_value(w);
+}
+
+void nebo_json_write_null(nebo_json_writer_t *w) {
+    if (!w || !begin_value(w)) return;
+    put(w, "null", 4);
+    end_value(w);
+}
+
+void nebo_json_write_raw(nebo_json_writer_t *w, const char *json, size_t len) {
+    if (!w || !begin_value(w)) return;
+    if (!json || len == 0) {
+        fail(w);
+        return;
+    }
+    put(w, json, len);
+    end_value(w);
+}
+
+/* ── Lifecycle ───────────────────────────────────────────────────────── */
+
+nebo_json_writer_t *nebo_json_writer_new(size_t capacity) {
+    nebo_json_writer_t *w = calloc(1, sizeof(nebo_json_writer_t));
+    if (!w) return NULL;
+    w->cap = capacity ? capacity : DEFAULT_CAPACITY;
+    w->buf = malloc(w->cap + 1);
+    if (!w->buf) {
+        free(w);
+        return NULL;
+    }
+    return w;
+}
+
+nebo_json_writer_t *nebo_json_writer_new_sink(const nebo_json_sink_t *sink) {
+    nebo_json_writer_t *w = calloc(1, sizeof(nebo_json_writer_t));
+    if (!w) return NULL;
+    w->sink = *sink;
+    return w;
+}
+
+const char *nebo_json_writer_data(const nebo_json_writer_t *w, size_t *len) {
+    if (len) *len = w ? w->len : 0;
+    return w ? w->buf : NULL;
+}
+
+int nebo_json_writer_finish(nebo_json_writer_t *w, char **out, size_t *len) {
+    if (out) *out = NULL;
+    if (len) *len = 0;
+    if (!w) return -1;
+    int ok = !w->failed && w->done;
+    if (w->sink.close) {
+        w->sink.close(w, ok);
+    } else if (ok && out) {
+        w->buf[w->len] = '\0';
+        *out = w->buf;
+        w->buf = NULL;
+    } else {
+        free(w->buf);
+    }
+    if (ok && len) *len = w->len;
+    free(w);
+    return ok ? 0 : -1;
+}
+
+void nebo_json_writer_free(nebo_json_writer_t *w) {
+    if (!w) return;
+    if (w->sink.close) w->sink.close(w, 0);
+    else free(w->buf);
+    free(w);
+}
@@ -0,0 +1,45 @@
+#ifndef NEBO_JSON_WRITER_H
+#define NEBO_JSON_WRITER_H
+
+#include <stddef.h>
+
+#include "nebo/json.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NEBO_JSON_WRITER_MAX_DEPTH 1024
+
+/**
+ * Where a writer's bytes live. grow() makes room for at least need more
+ * bytes past len, updating buf and cap; returns 0 on success. close() runs
+ * once, from finish or free, with ok = 0 when the document is discarded.
+ * A writer without a sink owns a malloc'd buffer.
+ */
+typedef struct {
+    int (*grow)(nebo_json_writer_t *w, size_t need);
+    void (*close)(nebo_json_writer_t *w, int ok);
+    void *ctx;
+} nebo_json_sink_t;
+
+struct nebo_json_writer {
+    char *buf;
+    size_t len;
+    size_t cap;
+    nebo_json_sink_t sink;
+    int failed;      /* out of memory or misuse; sticky */
+    int done;        /* the top-level value is complete */
+    int want_value;  /* a key was written; its value comes next */
+    unsigned depth;
+    unsigned char frames[NEBO_JSON_WRITER_MAX_DEPTH];
+};
+
+/** Create a writer whose buffer is managed by sink. */
+nebo_json_writer_t *nebo_json_writer_new_sink(const nebo_json_sink_t *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NEBO_JSON_WRITER_H */
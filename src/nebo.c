@@ -29,7 +29,21 @@ nebo_app_t *nebo_app_new(void) {
 }
 
 void nebo_app_register_tool(nebo_app_t *app, const nebo_tool_handler_t *handler) {
-    if (app) app->tool = handler;
+    if (!app || !handler) return;
+
+    /* Same name replaces the earlier registration */
+    for (int i = 0; i < app->tool_count; i++) {
+        const char *name = app->tools[i]->name;
+        if (name && handler->name && strcmp(name, handler->name) == 0) {
+            app->tools[i] = handler;
+            return;
+        }
+    }
+
+    const nebo_tool_handler_t **tools = realloc(app->tools, (app->tool_count + 1) * sizeof(*tools));
+    if (!tools) return;
+    tools[app->tool_count++] = handler;
+    app->tools = tools;
 }
 
 void nebo_app_register_channel(nebo_app_t *app, const nebo_channel_handler_t *handler) {
@@ -44,6 +58,14 @@ void nebo_app_register_ui(nebo_app_t *app, const nebo_ui_handler_t *handler) {
     if (app) app->ui = handler;
 }
 
+void nebo_app_serve_static(nebo_app_t *app, const char *url_prefix, const char *dir) {
+    if (!app || !url_prefix) return;
+    free(app->static_prefix);
+    free(app->static_dir);
+    app->static_prefix = strdup(url_prefix);
+    app->static_dir = strdup(dir ? dir : "");
+}
+
 void nebo_app_register_comm(nebo_app_t *app, const nebo_comm_handler_t *handler) {
     if (app) app->comm = handler;
 }
@@ -56,6 +78,16 @@ void nebo_app_on_configure(nebo_app_t *app, void (*callback)(const nebo_string_m
     if (app) app->on_configure = callback;
 }
 
+void nebo_app_set_engine(nebo_app_t *app, nebo_engine_t engine, int threads) {
+    if (!app) return;
+    app->engine = engine;
+    app->threads = threads;
+}
+
+void nebo_app_set_batch_parallelism(nebo_app_t *app, int threads) {
+    if (app) app->batch_threads = threads;
+}
+
 const char *nebo_app_dir(const nebo_app_t *app) { return app ? app->dir : ""; }
 const char *nebo_app_sock(const nebo_app_t *app) { return app ? app->sock_path : ""; }
 const char *nebo_app_id(const nebo_app_t *app) { return app ? app->id : ""; }
@@ -71,6 +103,9 @@ void nebo_app_free(nebo_app_t *app) {
     free(app->name);
     free(app->version);
     free(app->data_dir);
+    free(app->tools);
+    free(app->static_prefix);
+    free(app->static_dir);
     free(app);
 }
 
@@ -83,8 +118,8 @@ int nebo_app_run(nebo_app_t *app) {
         return 1;
     }
 
-    if (!app->tool && !app->channel && !app->gateway &&
-        !app->ui && !app->comm && !app->schedule) {
+    if (!app->tool_count && !app->channel && !app->gateway &&
+        !app->ui && !app->static_prefix && !app->comm && !app->schedule) {
         fprintf(stderr, "No handlers registered\n");
         nebo_app_free(app);
         return 1;
@@ -0,0 +1,106 @@
+/**
+ * Nebo C SDK — bounded lock-free queue.
+ *
+ * Internal to the C++ shim.
+ */
+
+#ifndef NEBO_RING_H
+#define NEBO_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Bounded multi-producer, multi-consumer ring (Vyukov). Each slot carries
+ * a sequence number that says whose turn it is, so producers and consumers
+ * each claim a slot with one CAS on their own cursor and never share a
+ * lock. Capacity is rounded up to a power of two.
+ */
+template <class T>
+class MpmcRing {
+public:
+    explicit MpmcRing(size_t capacity) {
+        size_t n = 2;
+        while (n < capacity) n *= 2;
+        mask_ = n - 1;
+        slots_.reset(new Slot[n]);
+        for (size_t i = 0; i < n; i++) slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcRing(const MpmcRing &) = delete;
+    MpmcRing &operator=(const MpmcRing &) = delete;
+
+    size_t Capacity() const { return mask_ + 1; }
+
+    /** Moves v in and returns true, or returns false (v untouched) when full. */
+    bool Push(T &v) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Slot *s;
+        for (;;) {
+            s = &slots_[pos & mask_];
+            size_t seq = s->seq.load(std::memory_order_acquire);
+            intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+            if (dif == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        s->value = std::move(v);
+        s->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Moves the oldest element out and returns true, or returns false when empty. */
+    bool Pop(T *out) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        Slot *s;
+        for (;;) {
+            s = &slots_[pos & mask_];
+            size_t seq = s->seq.load(std::memory_order_acquire);
+            intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (dif == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+        *out = std::move(s->value);
+        s->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* Snapshots; exact only when no push or pop is in progress. */
+    bool Empty() const {
+        size_t pos = head_.load(std::memory_order_acquire);
+        return slots_[pos & mask_].seq.load(std::memory_order_acquire) != pos + 1;
+    }
+    bool Full() const {
+        size_t pos = tail_.load(std::memory_order_acquire);
+        return slots_[pos & mask_].seq.load(std::memory_order_acquire) != pos;
+    }
+    size_t Size() const {
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t head = head_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+#endif /* NEBO_RING_H */
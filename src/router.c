@@ -0,0 +1,295 @@
+/**
+ * Nebo C SDK — radix-trie HTTP router.
+ *
+ * Each node matches a run of literal path bytes; its children split on
+ * their first byte. A node may also have one ":name" child and one "*name"
+ * child, tried in that order once the literal children fail, so a lookup
+ * backtracks only where literal and param patterns overlap. Nodes, labels
+ * and route lists live in the router's arena.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "nebo/router.h"
+
+typedef struct {
+    const char *method; /* NULL = any */
+    nebo_route_fn fn;
+    void *user_data;
+} route_t;
+
+typedef struct route_node route_node_t;
+
+struct route_node {
+    const char *label;    /* literal bytes; for a param or wildcard, its name */
+    size_t len;
+    char *firsts;         /* firsts[i] == kids[i]->label[0] */
+    route_node_t **kids;
+    int kid_count;
+    route_node_t *param;  /* ":name" child */
+    route_node_t *wild;   /* "*name" child; always a leaf */
+    route_t *routes;
+    int route_count;
+};
+
+struct nebo_router {
+    nebo_arena_t arena;
+    route_node_t root;
+};
+
+nebo_router_t *nebo_router_new(void) {
+    nebo_router_t *r = calloc(1, sizeof(nebo_router_t));
+    if (!r) return NULL;
+    nebo_arena_init(&r->arena, 0);
+    r->root.label = "";
+    return r;
+}
+
+void nebo_router_free(nebo_router_t *r) {
+    if (!r) return;
+    nebo_arena_free(&r->arena);
+    free(r);
+}
+
+/* ── Building ────────────────────────────────────────────────────────── */
+
+static route_node_t *new_node(nebo_router_t *r, const char *label, size_t len) {
+    route_node_t *n = nebo_arena_alloc(&r->arena, sizeof(route_node_t));
+    if (!n) return NULL;
+    memset(n, 0, sizeof(*n));
+    n->label = nebo_arena_strndup(&r->arena, label, len);
+    n->len = len;
+    return n->label ? n : NULL;
+}
+
+/* Arrays only grow while routes are added, so the old copy stays in the arena. */
+static int add_kid(nebo_router_t *r, route_node_t *n, route_node_t *kid) {
+    route_node_t **kids = nebo_arena_alloc(&r->arena, (size_t)(n->kid_count + 1) * sizeof(*kids));
+    char *firsts = nebo_arena_alloc(&r->arena, (size_t)n->kid_count + 1);
+    if (!kids || !firsts) return -1;
+    if (n->kid_count > 0) {
+        memcpy(kids, n->kids, (size_t)n->kid_count * sizeof(*kids));
+        memcpy(firsts, n->firsts, (size_t)n->kid_count);
+    }
+    kids[n->kid_count] = kid;
+    firsts[n->kid_count] = kid->label[0];
+    n->kids = kids;
+    n->firsts = firsts;
+    n->kid_count++;
+    return 0;
+}
+
+/** Descend from n along s[0..len), splitting labels as needed; returns the node at the end. */
+static route_node_t *insert_literal(nebo_router_t *r, route_node_t *n, const char *s, size_t len) {
+    while (len > 0) {
+        route_node_t *k = NULL;
+        for (int i = 0; i < n->kid_count; i++) {
+            if (n->firsts[i] == s[0]) {
+                k = n->kids[i];
+                break;
+            }
+        }
+        if (!k) {
+            route_node_t *leaf = new_node(r, s, len);
+            return leaf && add_kid(r, n, leaf) == 0 ? leaf : NULL;
+        }
+        size_t common = 0;
+        while (common < k->len && common < len && k->label[common] == s[common]) common++;
+        if (common < k->len) {
+            /* k keeps the shared prefix; a new child takes over the rest of it. */
+            route_node_t *tail = new_node(r, k->label + common, k->len - common);
+            if (!tail) return NULL;
+            tail->firsts = k->firsts;
+            tail->kids = k->kids;
+            tail->kid_count = k->kid_count;
+            tail->param = k->param;
+            tail->wild = k->wild;
+            tail->routes = k->routes;
+            tail->route_count = k->route_count;
+            k->len = common;
+            k->kids = NULL;
+            k->firsts = NULL;
+            k->kid_count = 0;
+            k->param = NULL;
+            k->wild = NULL;
+            k->routes = NULL;
+            k->route_count = 0;
+            if (add_kid(r, k, tail) != 0) return NULL;
+        }
+        n = k;
+        s += common;
+        len -= common;
+    }
+    return n;
+}
+
+/** Checks the pattern's shape before anything is inserted. */
+static int valid_pattern(const char *p) {
+    if (p[0] != '/') return 0;
+    int params = 0;
+    for (const char *c = p; *c; c++) {
+        if ((*c != ':' && *c != '*') || c[-1] != '/') continue;
+        const char *end = c + 1;
+        while (*end && *end != '/') end++;
+        if (end == c + 1) return 0;              /* unnamed */
+        if (*c == '*' && *end) return 0;         /* wildcard not last */
+        if (++params > NEBO_ROUTE_MAX_PARAMS) return 0;
+        c = end - 1;
+    }
+    return 1;
+}
+
+static int same_method(const char *a, const char *b) {
+    return a == b || (a && b && strcmp(a, b) == 0);
+}
+
+int nebo_router_add(nebo_router_t *r, const char *method, const char *pattern,
+                    nebo_route_fn fn, void *user_data) {
+    if (!r || !pattern || !fn || !valid_pattern(pattern)) return -1;
+    route_node_t *n = &r->root;
+    const char *p = pattern;
+    while (*p) {
+        if ((*p == ':' || *p == '*') && p[-1] == '/') {
+            const char *name = p + 1;
+            const char *end = name;
+            while (*end && *end != '/') end++;
+            route_node_t **slot = *p == ':' ? &n->param : &n->wild;
+            if (!*slot) {
+                *slot = new_node(r, name, (size_t)(end - name));
+                if (!*slot) return -1;
+            } else if ((*slot)->len != (size_t)(end - name) ||
+                       memcmp((*slot)->label, name, (*slot)->len) != 0) {
+                return -1; /* ":id" and ":name" at the same position */
+            }
+            n = *slot;
+            p = end;
+            continue;
+        }
+        const char *end = p;
+        while (*end && !((end[0] == ':' || end[0] == '*') && end[-1] == '/')) end++;
+        n = insert_literal(r, n, p, (size_t)(end - p));
+        if (!n) return -1;
+        p = end;
+    }
+
+    for (int i = 0; i < n->route_count; i++) {
+        if (same_method(n->routes[i].method, method)) return -1;
+    }
+    route_t *routes = nebo_arena_alloc(&r->arena, (size_t)(n->route_count + 1) * sizeof(route_t));
+    if (!routes) return -1;
+    if (n->route_count > 0) memcpy(routes, n->routes, (size_t)n->route_count * sizeof(route_t));
+    route_t *rt = &routes[n->route_count];
+    rt->method = method ? nebo_arena_strndup(&r->arena, method, strlen(method)) : NULL;
+    if (method && !rt->method) return -1;
+    rt->fn = fn;
+    rt->user_data = user_data;
+    n->routes = routes;
+    n->route_count++;
+    return 0;
+}
+
+/* ── Matching ────────────────────────────────────────────────────────── */
+
+typedef struct {
+    const char *method;
+    nebo_route_match_t *match;
+    int path_matched; /* some node ended the path, whatever its methods */
+} lookup_t;
+
+static const route_t *find_route(const route_node_t *n, const char *method) {
+    const route_t *any = NULL, *get = NULL;
+    for (int i = 0; i < n->route_count; i++) {
+        const route_t *rt = &n->routes[i];
+        if (!rt->method) any = rt;
+        else if (strcmp(rt->method, method) == 0) return rt;
+        else if (strcmp(rt->method, "GET") == 0) get = rt;
+    }
+    if (any) return any;
+    return get && strcmp(method, "HEAD") == 0 ? get : NULL;
+}
+
+static const route_t *accept_node(const route_node_t *n, lookup_t *l) {
+    if (n->route_count == 0) return NULL;
+    l->path_matched = 1;
+    return find_route(n, l->method);
+}
+
+static void push_param(lookup_t *l, const route_node_t *n, const char *value, size_t len) {
+    nebo_route_param_t *p = &l->match->params[l->match->param_count++];
+    p->name = n->label;
+    p->value = value;
+    p->len = len;
+}
+
+/** n's label has been consumed; match the rest of the path at p. */
+static const route_t *lookup(const route_node_t *n, const char *p, lookup_t *l) {
+    const route_t *rt;
+    if (*p == '\0') {
+        if ((rt = accept_node(n, l))) return rt;
+    } else {
+        for (int i = 0; i < n->kid_count; i++) {
+            if (n->firsts[i] != *p) continue;
+            const route_node_t *k = n->kids[i];
+            if (strncmp(k->label, p, k->len) == 0 && (rt = lookup(k, p + k->len, l))) return rt;
+            break;
+        }
+    }
+    int saved = l->match->param_count;
+    if (n->param && *p && *p != '/') {
+        const char *end = p;
+        while (*end && *end != '/') end++;
+        push_param(l, n->param, p, (size_t)(end - p));
+        if ((rt = lookup(n->param, end, l))) return rt;
+        l->match->param_count = saved;
+    }
+    if (n->wild) {
+        push_param(l, n->wild, p, strlen(p));
+        if ((rt = accept_node(n->wild, l))) return rt;
+        l->match->param_count = saved;
+    }
+    return NULL;
+}
+
+nebo_route_fn nebo_router_match(const nebo_router_t *r, const char *method, const char *path,
+                                nebo_route_match_t *match, int *status) {
+    nebo_route_match_t scratch;
+    if (!match) match = &scratch;
+    match->param_count = 0;
+    match->user_data = NULL;
+    lookup_t l = {method ? method : "", match, 0};
+    const route_t *rt = r && path ? lookup(&r->root, path, &l) : NULL;
+    if (!rt) {
+        match->param_count = 0;
+        if (status) *status = l.path_matched ? 405 : 404;
+        return NULL;
+    }
+    match->user_data = rt->user_data;
+    if (status) *status = 200;
+    return rt->fn;
+}
+
+int nebo_router_handle(const nebo_router_t *r, const nebo_http_request_t *req,
+                       nebo_http_response_t *resp) {
+    if (!req || !resp) return -1;
+    nebo_route_match_t match;
+    int status;
+    nebo_route_fn fn = nebo_router_match(r, req->method, req->path, &match, &status);
+    if (!fn) {
+        resp->status_code = status;
+        return 0;
+    }
+    return fn(req, &match, resp);
+}
+
+const char *nebo_route_param(const nebo_route_match_t *match, const char *name, size_t *len) {
+    if (!match || !name) return NULL;
+    for (int i = 0; i < match->param_count; i++) {
+        if (strcmp(match->params[i].name, name) == 0) {
+            if (len) *len = match->params[i].len;
+            return match->params[i].value;
+        }
+    }
+    return NULL;
+}
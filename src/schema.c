@@ -1,35 +1,15 @@
 /**
  * Nebo C SDK — JSON Schema builder for STRAP pattern tool inputs.
  *
- * Builds JSON manually to avoid requiring a JSON library dependency.
- * The output is a valid JSON Schema string.
+ * Serialized with the SDK's own JSON writer, so names, descriptions and
+ * enum values are escaped and there is no size limit.
  */
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
-#include "nebo/schema.h"
-
-#define MAX_PROPS 32
-#define MAX_ACTIONS 16
-#define MAX_ENUM_VALUES 32
-
-typedef struct {
-    char *name;
-    char *desc;
-    char *type;
-    int required;
-    char **enum_values; /* NULL if not an enum */
-    int enum_count;
-} schema_prop_t;
-
-struct nebo_schema_builder {
-    char *actions[MAX_ACTIONS];
-    int action_count;
-    schema_prop_t props[MAX_PROPS];
-    int prop_count;
-};
+#include "internal.h"
 
 nebo_schema_builder_t *nebo_schema_new(const char **actions) {
     nebo_schema_builder_t *b = calloc(1, sizeof(nebo_schema_builder_t));
@@ -97,52 +77,75 @@ nebo_schema_builder_t *nebo_schema_object(nebo_schema_builder_t *b, const char *
 char *nebo_schema_build(nebo_schema_builder_t *b) {
     if (!b) return NULL;
 
-    size_t bufsize = 8192;
-    char *buf = malloc(bufsize);
-    if (!buf) return NULL;
+    nebo_json_writer_t *w = nebo_json_writer_new(1024);
+    if (!w) return NULL;
 
-    int pos = 0;
-    pos += snprintf(buf + pos, bufsize - pos, "{\"type\":\"object\",\"properties\":{");
+    nebo_json_write_begin_object(w);
+    nebo_json_write_key(w, "type");
+    nebo_json_write_string(w, "object");
+    nebo_json_write_key(w, "properties");
+    nebo_json_write_begin_object(w);
 
     /* Action field */
-    pos += snprintf(buf + pos, bufsize - pos, "\"action\":{\"type\":\"string\",\"enum\":[");
+    nebo_json_write_key(w, "action");
+    nebo_json_write_begin_object(w);
+    nebo_json_write_key(w, "type");
+    nebo_json_write_string(w, "string");
+    nebo_json_write_key(w, "enum");
+    nebo_json_write_begin_array(w);
+    size_t desc_len = sizeof("Action to perform: ");
     for (int i = 0; i < b->action_count; i++) {
-        if (i > 0) pos += snprintf(buf + pos, bufsize - pos, ",");
-        pos += snprintf(buf + pos, bufsize - pos, "\"%s\"", b->actions[i]);
+        nebo_json_write_string(w, b->actions[i]);
+        desc_len += strlen(b->actions[i]) + 2;
     }
-    pos += snprintf(buf + pos, bufsize - pos, "],\"description\":\"Action to perform: ");
-    for (int i = 0; i < b->action_count; i++) {
-        if (i > 0) pos += snprintf(buf + pos, bufsize - pos, ", ");
-        pos += snprintf(buf + pos, bufsize - pos, "%s", b->actions[i]);
+    nebo_json_write_end_array(w);
+
+    char *desc = malloc(desc_len);
+    if (!desc) {
+        nebo_json_writer_free(w);
+        return NULL;
     }
-    pos += snprintf(buf + pos, bufsize - pos, "\"}");
+    char *d = desc;
+    d += sprintf(d, "Action to perform: ");
+    for (int i = 0; i < b->action_count; i++)
+        d += sprintf(d, i > 0 ? ", %s" : "%s", b->actions[i]);
+    nebo_json_write_key(w, "description");
+    nebo_json_write_stringn(w, desc, (size_t)(d - desc));
+    free(desc);
+    nebo_json_write_end_object(w);
 
     /* Additional properties */
     for (int i = 0; i < b->prop_count; i++) {
         schema_prop_t *p = &b->props[i];
-        pos += snprintf(buf + pos, bufsize - pos,
-            ",\"%s\":{\"type\":\"%s\",\"description\":\"%s\"",
-            p->name, p->type, p->desc);
+        nebo_json_write_key(w, p->name);
+        nebo_json_write_begin_object(w);
+        nebo_json_write_key(w, "type");
+        nebo_json_write_string(w, p->type);
+        nebo_json_write_key(w, "description");
+        nebo_json_write_string(w, p->desc);
         if (p->enum_values) {
-            pos += snprintf(buf + pos, bufsize - pos, ",\"enum\":[");
-            for (int j = 0; j < p->enum_count; j++) {
-                if (j > 0) pos += snprintf(buf + pos, bufsize - pos, ",");
-                pos += snprintf(buf + pos, bufsize - pos, "\"%s\"", p->enum_values[j]);
-            }
-            pos += snprintf(buf + pos, bufsize - pos, "]");
+            nebo_json_write_key(w, "enum");
+            nebo_json_write_begin_array(w);
+            for (int j = 0; j < p->enum_count; j++)
+                nebo_json_write_string(w, p->enum_values[j]);
+            nebo_json_write_end_array(w);
         }
-        pos += snprintf(buf + pos, bufsize - pos, "}");
+        nebo_json_write_end_object(w);
     }
+    nebo_json_write_end_object(w);
 
-    pos += snprintf(buf + pos, bufsize - pos, "},\"required\":[\"action\"");
+    nebo_json_write_key(w, "required");
+    nebo_json_write_begin_array(w);
+    nebo_json_write_string(w, "action");
     for (int i = 0; i < b->prop_count; i++) {
-        if (b->props[i].required) {
-            pos += snprintf(buf + pos, bufsize - pos, ",\"%s\"", b->props[i].name);
-        }
+        if (b->props[i].required) nebo_json_write_string(w, b->props[i].name);
     }
-    pos += snprintf(buf + pos, bufsize - pos, "]}");
+    nebo_json_write_end_array(w);
+    nebo_json_write_end_object(w);
 
-    return buf;
+    char *json = NULL;
+    nebo_json_writer_finish(w, &json, NULL);
+    return json;
 }
 
 void nebo_schema_free(nebo_schema_builder_t *b) {
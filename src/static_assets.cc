@@ -0,0 +1,210 @@
+/**
+ * Nebo C SDK — static asset server for UI apps.
+ *
+ * Files are read into memory at startup rather than mapped: an edit or a
+ * truncation of a mapped file would change the bytes under their ETag or
+ * fault the process. Each gets a strong ETag from its bytes and, when its
+ * type compresses and gzip saves at least a tenth, a gzip variant with its
+ * own ETag, so a request costs a hash lookup and a copy into the response.
+ */
+
+#include "static_assets.h"
+#include "http_headers.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <cstdlib>
+#include <strings.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <zlib.h>
+
+extern "C" {
+#include "hash.h"
+}
+
+namespace apb = apps::v0;
+
+/* Deeper trees are skipped; also stops symlink loops. */
+static const int kMaxDepth = 16;
+/* Below this gzip's header and trailer eat most of the saving. */
+static const size_t kMinGzipBytes = 256;
+
+struct MimeType {
+    const char *ext;
+    const char *mime;
+    bool compress;
+};
+
+static const MimeType kMimeTypes[] = {
+    {"html", "text/html; charset=utf-8", true},
+    {"htm", "text/html; charset=utf-8", true},
+    {"css", "text/css; charset=utf-8", true},
+    {"js", "text/javascript; charset=utf-8", true},
+    {"mjs", "text/javascript; charset=utf-8", true},
+    {"json", "application/json", true},
+    {"map", "application/json", true},
+    {"txt", "text/plain; charset=utf-8", true},
+    {"xml", "application/xml", true},
+    {"svg", "image/svg+xml", true},
+    {"wasm", "application/wasm", true},
+    {"ico", "image/x-icon", true},
+    {"png", "image/png", false},
+    {"jpg", "image/jpeg", false},
+    {"jpeg", "image/jpeg", false},
+    {"gif", "image/gif", false},
+    {"webp", "image/webp", false},
+    {"woff", "font/woff", false},
+    {"woff2", "font/woff2", false},
+    {"ttf", "font/ttf", true},
+};
+
+static const MimeType *mime_for(const std::string &path) {
+    size_t slash = path.rfind('/');
+    size_t dot = path.rfind('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return nullptr;
+    const char *ext = path.c_str() + dot + 1;
+    for (const MimeType &m : kMimeTypes) {
+        if (strcasecmp(ext, m.ext) == 0) return &m;
+    }
+    return nullptr;
+}
+
+static std::string etag_of(uint64_t hash, const char *suffix) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "\"%016llx%s\"", (unsigned long long)hash, suffix);
+    return buf;
+}
+
+static bool gzip(const char *data, size_t len, std::string *out) {
+    if (len > UINT_MAX) return false;
+    z_stream zs{};
+    if (deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK)
+        return false;
+    out->resize(deflateBound(&zs, (uLong)len));
+    zs.next_in = (Bytef *)data;
+    zs.avail_in = (uInt)len;
+    zs.next_out = (Bytef *)&(*out)[0];
+    zs.avail_out = (uInt)out->size();
+    int rc = deflate(&zs, Z_FINISH);
+    out->resize(zs.total_out);
+    deflateEnd(&zs);
+    return rc == Z_STREAM_END;
+}
+
+StaticAssets::StaticAssets(const std::string &root, const std::string &prefix) : prefix_(prefix) {
+    while (!prefix_.empty() && prefix_.back() == '/') prefix_.pop_back();
+    struct stat st;
+    if (stat(root.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+        fprintf(stderr, "static assets: %s is not a directory\n", root.c_str());
+        return;
+    }
+    Load(root, prefix_, 0);
+}
+
+void StaticAssets::Load(const std::string &dir, const std::string &url, int depth) {
+    if (depth > kMaxDepth) return;
+    DIR *d = opendir(dir.c_str());
+    if (!d) return;
+    while (struct dirent *e = readdir(d)) {
+        if (e->d_name[0] == '.') continue; /* ., .., and dotfiles such as .git */
+        std::string path = dir + "/" + e->d_name;
+        std::string child = url + "/" + e->d_name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) Load(path, child, depth + 1);
+        else if (S_ISREG(st.st_mode)) Add(path, child);
+    }
+    closedir(d);
+}
+
+/* Reads the whole file; its size may differ from what stat said. */
+static bool read_file(const std::string &path, std::string *out) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    char buf[64 * 1024];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) != 0) {
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) break;
+        out->append(buf, (size_t)n);
+    }
+    close(fd);
+    return n == 0;
+}
+
+void StaticAssets::Add(const std::string &path, const std::string &url) {
+    Asset a;
+    if (!read_file(path, &a.data)) return;
+    size_t len = a.data.size();
+    const MimeType *m = mime_for(path);
+    a.mime = m ? m->mime : "application/octet-stream";
+    uint64_t hash = nebo_fnv1a(a.data.data(), len);
+    a.etag = etag_of(hash, "");
+    if (m && m->compress && len >= kMinGzipBytes && gzip(a.data.data(), len, &a.gzip) &&
+        a.gzip.size() <= len - len / 10) {
+        a.gzip_etag = etag_of(hash, "-gz");
+    } else {
+        a.gzip.clear();
+        a.gzip.shrink_to_fit();
+    }
+    assets_[url] = std::move(a);
+}
+
+/* ── Request side ────────────────────────────────────────────────────── */
+
+static bool accepts_gzip(const std::string *accept) {
+    if (!accept) return false;
+    return http_any_element(*accept, [](const std::string &coding, const std::string &params) {
+        if (strcasecmp(coding.c_str(), "gzip") != 0) return false;
+        size_t q = params.find("q=");
+        return q == std::string::npos || atof(params.c_str() + q + 2) > 0;
+    });
+}
+
+/* If-None-Match uses the weak comparison: W/"x" matches "x". */
+static bool etag_matches(const std::string *if_none_match, const std::string &etag) {
+    if (!if_none_match) return false;
+    return http_any_element(*if_none_match, [&etag](const std::string &tag, const std::string &) {
+        if (tag == "*") return true;
+        return tag.compare(tag.rfind("W/", 0) == 0 ? 2 : 0, std::string::npos, etag) == 0;
+    });
+}
+
+bool StaticAssets::Serve(const apb::HttpRequest &req, apb::HttpResponse *resp) const {
+    bool head = req.method() == "HEAD";
+    if (!head && req.method() != "GET") return false;
+    const std::string &path = req.path();
+    auto it = assets_.end();
+    if (path.empty() || path.back() == '/') it = assets_.find(path + "index.html");
+    else if (path == prefix_) it = assets_.find(path + "/index.html");
+    else it = assets_.find(path);
+    if (it == assets_.end()) return false;
+
+    const Asset &a = it->second;
+    bool gz = !a.gzip.empty() && accepts_gzip(http_find_header(req.headers(), "Accept-Encoding"));
+    const std::string &etag = gz ? a.gzip_etag : a.etag;
+    auto &h = *resp->mutable_headers();
+    h["ETag"] = etag;
+    h["Cache-Control"] = "no-cache"; /* revalidate each time: a 304 is cheap */
+    if (!a.gzip.empty()) h["Vary"] = "Accept-Encoding";
+    if (etag_matches(http_find_header(req.headers(), "If-None-Match"), etag)) {
+        resp->set_status_code(304);
+        return true;
+    }
+
+    const std::string &body = gz ? a.gzip : a.data;
+    size_t len = body.size();
+    resp->set_status_code(200);
+    h["Content-Type"] = a.mime;
+    h["Content-Length"] = std::to_string(len);
+    if (gz) h["Content-Encoding"] = "gzip";
+    if (!head && len > 0) resp->set_body(body);
+    return true;
+}
@@ -0,0 +1,55 @@
+/**
+ * Nebo C SDK — static asset server for UI apps.
+ *
+ * Internal to the C++ shim. The UI bridge owns one StaticAssets when the
+ * app called nebo_app_serve_static, and asks it first for every request.
+ */
+
+#ifndef NEBO_STATIC_ASSETS_H
+#define NEBO_STATIC_ASSETS_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include "proto/apps/v0/ui.pb.h"
+
+/**
+ * Every regular file under a directory, read and hashed once. Lookups
+ * never touch the filesystem, so a request can only reach the files that
+ * were there at startup, with the bytes they had then.
+ */
+class StaticAssets {
+public:
+    /** Loads root recursively; files answer at prefix + their relative path. */
+    StaticAssets(const std::string &root, const std::string &prefix);
+
+    StaticAssets(const StaticAssets &) = delete;
+    StaticAssets &operator=(const StaticAssets &) = delete;
+
+    /**
+     * Answers a GET or HEAD for a loaded file, including 304s for a matching
+     * If-None-Match. Returns false, leaving resp untouched, for anything
+     * else, which then goes to the app's handler.
+     */
+    bool Serve(const apps::v0::HttpRequest &req, apps::v0::HttpResponse *resp) const;
+
+    size_t Count() const { return assets_.size(); }
+
+private:
+    struct Asset {
+        std::string data;           /* owned: the file may change or shrink later */
+        const char *mime = nullptr;
+        std::string etag;           /* quoted strong ETag of the bytes */
+        std::string gzip;           /* empty unless it saves space */
+        std::string gzip_etag;
+    };
+
+    void Load(const std::string &dir, const std::string &url, int depth);
+    void Add(const std::string &path, const std::string &url);
+
+    std::string prefix_;
+    std::unordered_map<std::string, Asset> assets_;
+};
+
+#endif /* NEBO_STATIC_ASSETS_H */
@@ -0,0 +1,91 @@
+/**
+ * Nebo C SDK — per-tool admission control for Execute.
+ */
+
+#include "tool_admission.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+/* Controllers by handler, so nebo_tool_admission_stats can find a served tool. */
+static std::mutex g_registry_mu;
+static std::unordered_map<const nebo_tool_handler_t *, ToolAdmission *> g_registry;
+
+ToolAdmission::ToolAdmission(const nebo_tool_handler_t *tool, int max_in_flight, int max_queued)
+    : tool_(tool),
+      max_in_flight_(max_in_flight),
+      max_queued_(max_queued > 0 ? (size_t)max_queued : 0) {
+    std::lock_guard<std::mutex> lk(g_registry_mu);
+    g_registry[tool_] = this;
+}
+
+ToolAdmission::~ToolAdmission() {
+    std::lock_guard<std::mutex> lk(g_registry_mu);
+    auto it = g_registry.find(tool_);
+    if (it != g_registry.end() && it->second == this) g_registry.erase(it);
+}
+
+ToolAdmission::Result ToolAdmission::Enter(Resume resume, uint64_t *ticket) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (stats_.in_flight < max_in_flight_) {
+        stats_.in_flight++;
+        stats_.admitted++;
+        return kRun;
+    }
+    if (queue_.size() >= max_queued_) {
+        stats_.rejected++;
+        return kFull;
+    }
+    queue_.push_back(Waiter{std::move(resume), Clock::now(), ++next_ticket_});
+    if (ticket) *ticket = next_ticket_;
+    stats_.queued = (int)queue_.size();
+    return kQueued;
+}
+
+bool ToolAdmission::Cancel(uint64_t ticket) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = std::find_if(queue_.begin(), queue_.end(),
+                           [ticket](const Waiter &w) { return w.ticket == ticket; });
+    if (it == queue_.end()) return false;
+    queue_.erase(it);
+    stats_.queued = (int)queue_.size();
+    stats_.abandoned++;
+    return true;
+}
+
+void ToolAdmission::Leave() {
+    Waiter next;
+    uint64_t wait_us;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (queue_.empty()) {
+            stats_.in_flight--;
+            return;
+        }
+        /* The slot passes straight to the waiter; in_flight is unchanged. */
+        next = std::move(queue_.front());
+        queue_.pop_front();
+        stats_.queued = (int)queue_.size();
+        stats_.admitted++;
+        wait_us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - next.since).count();
+        stats_.wait_us_total += wait_us;
+        if (wait_us > stats_.wait_us_max) stats_.wait_us_max = wait_us;
+    }
+    next.resume(wait_us);
+}
+
+nebo_tool_admission_stats_t ToolAdmission::Stats() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return stats_;
+}
+
+extern "C" int nebo_tool_admission_stats(const nebo_tool_handler_t *tool,
+                                         nebo_tool_admission_stats_t *out) {
+    if (!tool || !out) return -1;
+    std::lock_guard<std::mutex> lk(g_registry_mu);
+    auto it = g_registry.find(tool);
+    if (it == g_registry.end()) return -1;
+    *out = it->second->Stats();
+    return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * Nebo C SDK — per-tool admission control for Execute.
+ *
+ * Internal to the C++ shim. One ToolAdmission sits in front of each tool
+ * registered with max_in_flight > 0.
+ */
+
+#ifndef NEBO_TOOL_ADMISSION_H
+#define NEBO_TOOL_ADMISSION_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+extern "C" {
+#include "nebo/tool.h"
+}
+
+/**
+ * Counting semaphore with a bounded FIFO of waiters. A call either takes a
+ * free slot, queues for one, or is rejected when the queue is full.
+ */
+class ToolAdmission {
+public:
+    enum Result { kRun, kQueued, kFull };
+
+    /* Called with the time spent queued once a slot is handed over. */
+    using Resume = std::function<void(uint64_t wait_us)>;
+
+    ToolAdmission(const nebo_tool_handler_t *tool, int max_in_flight, int max_queued);
+    ~ToolAdmission();
+
+    /**
+     * kRun: the caller holds a slot now. kQueued: resume is called from the
+     * Leave() that frees a slot, and the resumed call then holds it; ticket,
+     * if given, names the queue entry for Cancel. kFull: rejected; resume
+     * is never called.
+     */
+    Result Enter(Resume resume, uint64_t *ticket = nullptr);
+
+    /**
+     * Withdraws a queued call whose RPC ended. Returns true if it left the
+     * queue and resume will never be called; false if it was already
+     * resumed, so the caller holds a slot and must Leave().
+     */
+    bool Cancel(uint64_t ticket);
+
+    /** Releases the caller's slot, handing it to the oldest waiter if any. */
+    void Leave();
+
+    nebo_tool_admission_stats_t Stats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Waiter {
+        Resume resume;
+        Clock::time_point since;
+        uint64_t ticket;
+    };
+
+    const nebo_tool_handler_t *tool_;
+    int max_in_flight_;
+    size_t max_queued_;
+
+    std::mutex mu_;
+    std::deque<Waiter> queue_;
+    uint64_t next_ticket_ = 0;
+    nebo_tool_admission_stats_t stats_{};
+};
+
+#endif /* NEBO_TOOL_ADMISSION_H */
@@ -0,0 +1,261 @@
+/**
+ * Nebo C SDK — memoizing result cache for deterministic tools.
+ */
+
+#include "tool_cache.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "hash.h"
+#include "json_lex.h"
+}
+
+namespace apb = apps::v0;
+
+static const size_t kDefaultMaxBytes = 16u << 20;
+
+/* Caches by handler, so nebo_tool_cache_stats can find a served tool. */
+static std::mutex g_registry_mu;
+static std::unordered_map<const nebo_tool_handler_t *, ToolCache *> g_registry;
+
+/* Whitespace outside strings removed; the fallback for input that does not parse. */
+static std::string strip_json_ws(const char *data, size_t len) {
+    std::string out;
+    out.reserve(len);
+    bool in_string = false;
+    for (size_t i = 0; i < len; i++) {
+        char c = data[i];
+        if (in_string) {
+            out.push_back(c);
+            if (c == '\\' && i + 1 < len) out.push_back(data[++i]);
+            else if (c == '"') in_string = false;
+            continue;
+        }
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') continue;
+        if (c == '"') in_string = true;
+        out.push_back(c);
+    }
+    return out;
+}
+
+/*
+ * Number text with the same value written one way: digits without leading
+ * or trailing zeros and a plain exponent, so 1.50, 15e-1 and 0.15E1 all
+ * become 15e-1. Exact, unlike a trip through double.
+ */
+static std::string canonical_number(const char *s, size_t len) {
+    const char *start = s, *end = s + len;
+    std::string out;
+    if (*s == '-') out.push_back(*s++);
+    std::string digits;
+    long long exp = 0;
+    for (; s < end && *s >= '0' && *s <= '9'; s++) digits.push_back(*s);
+    if (s < end && *s == '.') {
+        for (s++; s < end && *s >= '0' && *s <= '9'; s++, exp--) digits.push_back(*s);
+    }
+    if (s < end) { /* e or E */
+        s++;
+        bool neg = *s == '-';
+        if (*s == '-' || *s == '+') s++;
+        if (end - s > 9) return std::string(start, len); /* too long to add up; as written */
+        long long e = 0;
+        for (; s < end; s++) e = e * 10 + (*s - '0');
+        exp += neg ? -e : e;
+    }
+    size_t first = digits.find_first_not_of('0');
+    if (first == std::string::npos) return out + "0";
+    size_t last = digits.find_last_not_of('0');
+    exp += (long long)(digits.size() - 1 - last);
+    out.append(digits, first, last - first + 1);
+    if (exp) out += "e" + std::to_string(exp);
+    return out;
+}
+
+static void write_canonical(nebo_json_writer_t *w, nebo_json_t v) {
+    size_t len;
+    switch (nebo_json_type(v)) {
+    case NEBO_JSON_OBJECT: {
+        std::vector<nebo_json_t> members;
+        for (nebo_json_t m = nebo_json_first(v); m.doc; m = nebo_json_next(m)) members.push_back(m);
+        /* Stable, so duplicate keys keep the order the tool would see. */
+        std::stable_sort(members.begin(), members.end(), [](nebo_json_t a, nebo_json_t b) {
+            size_t al, bl;
+            const char *ak = nebo_json_key(a, &al), *bk = nebo_json_key(b, &bl);
+            int c = std::memcmp(ak, bk, std::min(al, bl));
+            return c < 0 || (c == 0 && al < bl);
+        });
+        nebo_json_write_begin_object(w);
+        for (nebo_json_t m : members) {
+            const char *key = nebo_json_key(m, &len);
+            nebo_json_write_keyn(w, key, len);
+            write_canonical(w, m);
+        }
+        nebo_json_write_end_object(w);
+        break;
+    }
+    case NEBO_JSON_ARRAY:
+        nebo_json_write_begin_array(w);
+        for (nebo_json_t e = nebo_json_first(v); e.doc; e = nebo_json_next(e)) write_canonical(w, e);
+        nebo_json_write_end_array(w);
+        break;
+    case NEBO_JSON_STRING: {
+        const char *s = nebo_json_string(v, &len);
+        nebo_json_write_stringn(w, s, len);
+        break;
+    }
+    case NEBO_JSON_NUMBER: {
+        const char *text = nebo_json_number_text(v, &len);
+        std::string n = canonical_number(text, len);
+        nebo_json_write_raw(w, n.data(), n.size());
+        break;
+    }
+    case NEBO_JSON_TRUE:
+    case NEBO_JSON_FALSE:
+        nebo_json_write_bool(w, nebo_json_bool(v));
+        break;
+    default:
+        nebo_json_write_null(w);
+        break;
+    }
+}
+
+std::string nebo_canonical_json(const char *data, size_t len) {
+    nebo_json_doc_t *doc = nebo_json_parse(data, len, nullptr, 0);
+    if (!doc) return strip_json_ws(data, len);
+    nebo_json_writer_t *w = nebo_json_writer_new(len + 16);
+    write_canonical(w, nebo_json_root(doc));
+    nebo_json_free(doc);
+    char *out;
+    size_t out_len;
+    if (nebo_json_writer_finish(w, &out, &out_len) != 0) return strip_json_ws(data, len);
+    std::string key(out, out_len);
+    free(out);
+    return key;
+}
+
+size_t ToolCache::KeyHash::operator()(const std::string &s) const {
+    return (size_t)nebo_fnv1a(s.data(), s.size());
+}
+
+ToolCache::ToolCache(const nebo_tool_handler_t *tool, size_t max_bytes, int ttl_ms)
+    : tool_(tool),
+      max_bytes_(max_bytes ? max_bytes : kDefaultMaxBytes),
+      ttl_(ttl_ms > 0 ? ttl_ms : 0) {
+    std::lock_guard<std::mutex> lk(g_registry_mu);
+    g_registry[tool_] = this;
+}
+
+ToolCache::~ToolCache() {
+    std::lock_guard<std::mutex> lk(g_registry_mu);
+    auto it = g_registry.find(tool_);
+    if (it != g_registry.end() && it->second == this) g_registry.erase(it);
+}
+
+void ToolCache::Execute(const std::string &input, apb::ExecuteResponse *resp,
+                        Finish finish, const Runner &run) {
+    std::string key = nebo_canonical_json(input.data(), input.size());
+    bool hit = false;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        auto it = index_.find(key);
+        if (it != index_.end() && ttl_.count() && Clock::now() >= it->second->expires) {
+            EraseLocked(it->second);
+            stats_.evictions++;
+            it = index_.end();
+        }
+        if (it != index_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            resp->set_content(it->second->content);
+            stats_.hits++;
+            hit = true;
+        } else {
+            auto flight = flights_.find(key);
+            if (flight != flights_.end()) {
+                flight->second.push_back(Waiter{resp, std::move(finish), run});
+                stats_.collapsed++;
+                return;
+            }
+            flights_.emplace(key, std::vector<Waiter>());
+            stats_.misses++;
+        }
+    }
+    if (hit) {
+        finish(grpc::Status::OK);
+        return;
+    }
+    run(resp, [this, key, resp, finish](grpc::Status s) { Complete(key, resp, finish, s); }, false);
+}
+
+void ToolCache::Complete(const std::string &key, apb::ExecuteResponse *resp,
+                         const Finish &finish, grpc::Status status) {
+    /* A failure belongs to the leader's own call (cancelled, past its
+     * deadline, ...), so waiters only ever share a success. */
+    bool shared = status.ok() && !resp->is_error();
+    std::vector<Waiter> waiters;
+    Waiter next{};
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        auto flight = flights_.find(key);
+        if (flight != flights_.end() && !shared && !flight->second.empty()) {
+            /* The flight stays open: the rest wait on the promoted waiter. */
+            next = std::move(flight->second.front());
+            flight->second.erase(flight->second.begin());
+        } else if (flight != flights_.end()) {
+            waiters.swap(flight->second);
+            flights_.erase(flight);
+        }
+        if (shared) Insert(key, resp->content());
+    }
+    /* The leader's finish may release resp, so serve waiters first. */
+    for (Waiter &w : waiters) {
+        w.resp->set_content(resp->content());
+        w.finish(status);
+    }
+    finish(status);
+    if (next.run) {
+        apb::ExecuteResponse *r = next.resp;
+        Finish f = std::move(next.finish);
+        next.run(r, [this, key, r, f](grpc::Status s) { Complete(key, r, f, s); }, true);
+    }
+}
+
+void ToolCache::Insert(const std::string &key, const std::string &content) {
+    size_t size = key.size() + content.size();
+    if (size > max_bytes_) return;
+    auto old = index_.find(key);
+    if (old != index_.end()) EraseLocked(old->second);
+    while (stats_.bytes + size > max_bytes_ && !lru_.empty()) {
+        EraseLocked(std::prev(lru_.end()));
+        stats_.evictions++;
+    }
+    lru_.push_front(Entry{key, content, Clock::now() + ttl_});
+    index_.emplace(key, lru_.begin());
+    stats_.bytes += size;
+    stats_.entries++;
+}
+
+void ToolCache::EraseLocked(std::list<Entry>::iterator it) {
+    stats_.bytes -= it->key.size() + it->content.size();
+    stats_.entries--;
+    index_.erase(it->key);
+    lru_.erase(it);
+}
+
+nebo_tool_cache_stats_t ToolCache::Stats() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return stats_;
+}
+
+extern "C" int nebo_tool_cache_stats(const nebo_tool_handler_t *tool,
+                                     nebo_tool_cache_stats_t *out) {
+    if (!tool || !out) return -1;
+    std::lock_guard<std::mutex> lk(g_registry_mu);
+    auto it = g_registry.find(tool);
+    if (it == g_registry.end()) return -1;
+    *out = it->second->Stats();
+    return 0;
+}
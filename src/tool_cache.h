@@ -0,0 +1,97 @@
+/**
+ * Nebo C SDK — memoizing result cache for deterministic tools.
+ *
+ * Internal to the C++ shim. One ToolCache sits in front of each tool
+ * registered with cache = 1.
+ */
+
+#ifndef NEBO_TOOL_CACHE_H
+#define NEBO_TOOL_CACHE_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+#include "proto/apps/v0/tool.pb.h"
+
+extern "C" {
+#include "nebo/tool.h"
+}
+
+/**
+ * Byte-bounded LRU with optional TTL and single-flight. Keys are the
+ * canonicalized input; values are successful, non-error responses.
+ */
+class ToolCache {
+public:
+    using Finish = std::function<void(grpc::Status)>;
+    /* Executes the call into resp. promoted: it takes over a flight whose
+     * leader failed, and is started from the thread that completed it. */
+    using Runner = std::function<void(apps::v0::ExecuteResponse *, Finish, bool promoted)>;
+
+    ToolCache(const nebo_tool_handler_t *tool, size_t max_bytes, int ttl_ms);
+    ~ToolCache();
+
+    /**
+     * Serves input from the cache, joins an identical in-flight call, or
+     * calls run to execute it. finish is called exactly once, possibly from
+     * another thread. A joined call shares only an OK, non-error result;
+     * when the leader fails, is cancelled or times out, one waiter is
+     * promoted and runs itself, and the rest join it.
+     */
+    void Execute(const std::string &input, apps::v0::ExecuteResponse *resp,
+                 Finish finish, const Runner &run);
+
+    nebo_tool_cache_stats_t Stats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string key;
+        std::string content;
+        Clock::time_point expires;
+    };
+
+    struct Waiter {
+        apps::v0::ExecuteResponse *resp;
+        Finish finish;
+        Runner run; /* its own call's runner, should it be promoted */
+    };
+
+    struct KeyHash {
+        size_t operator()(const std::string &s) const;
+    };
+
+    void Complete(const std::string &key, apps::v0::ExecuteResponse *resp,
+                  const Finish &finish, grpc::Status status);
+    void Insert(const std::string &key, const std::string &content);
+    void EraseLocked(std::list<Entry>::iterator it);
+
+    const nebo_tool_handler_t *tool_;
+    size_t max_bytes_;
+    std::chrono::milliseconds ttl_;
+
+    std::mutex mu_;
+    std::list<Entry> lru_; /* front = most recently used */
+    std::unordered_map<std::string, std::list<Entry>::iterator, KeyHash> index_;
+    std::unordered_map<std::string, std::vector<Waiter>, KeyHash> flights_;
+    nebo_tool_cache_stats_t stats_{};
+};
+
+/**
+ * The input re-serialized with object keys sorted, strings re-escaped and
+ * numbers written one way, so inputs that mean the same to a tool share a
+ * key. Input that does not parse only loses whitespace outside strings.
+ */
+std::string nebo_canonical_json(const char *data, size_t len);
+
+#endif /* NEBO_TOOL_CACHE_H */
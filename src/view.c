@@ -1,94 +1,217 @@
 /**
  * Nebo C SDK — ViewBuilder for fluent UI construction.
+ *
+ * Every string a builder copies lives in one bump arena. nebo_view_build()
+ * packs the blocks into that arena and hands it to the view, so freeing a
+ * view is one arena release no matter how many blocks it holds. Block types,
+ * the well-known variants and toggle values are interned: they point at
+ * static strings and cost nothing to copy.
+ *
+ * Built views are immutable and reference counted. A derived view points at
+ * its base's strings and holds a reference to the base; after
+ * VIEW_MAX_DEPTH derives in a row the next one is a full copy, so a session
+ * that keeps deriving from its own last view does not pin every ancestor.
  */
 
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "arena.h"
 #include "nebo/view.h"
 
-#define MAX_BLOCKS 64
+#define VIEW_ARENA_BLOCK 1024
+#define VIEW_MIN_BLOCKS 16
+#define VIEW_MAX_DEPTH 8
 
 struct nebo_view_builder {
-    char *view_id;
-    char *title;
-    nebo_ui_block_t blocks[MAX_BLOCKS];
+    nebo_arena_t arena;
+    const char *view_id;
+    const char *title;
+    nebo_ui_block_t *blocks;
     int block_count;
+    int block_cap;
+    int failed; /* out of memory; build() returns NULL */
 };
 
-static const char *safe_strdup(const char *s) {
-    return s ? strdup(s) : NULL;
+/** A built view and the arena behind its strings. */
+typedef struct owned_view owned_view_t;
+struct owned_view {
+    nebo_ui_view_t view; /* first: the public pointer is the allocation */
+    atomic_int refs;
+    int depth;           /* derives since the last full copy */
+    owned_view_t *base;  /* the view whose strings this one shares, or NULL */
+    nebo_arena_t arena;
+};
+
+/* ── Interning ───────────────────────────────────────────────────────── */
+
+static const char *const interned[] = {
+    "text", "heading", "input", "button", "select", "toggle", "divider", "image",
+    "h1", "h2", "h3",
+    "primary", "secondary", "ghost", "error",
+    "compact", "full-width",
+    "true", "false",
+};
+
+static const char *arena_dup(nebo_arena_t *a, const char *s, int *failed) {
+    if (!s) return NULL;
+    char *p = nebo_arena_strndup(a, s, strlen(s));
+    if (!p) *failed = 1;
+    return p;
+}
+
+/** s as its static copy if it is a well-known type or variant; else an arena copy. */
+static const char *arena_intern(nebo_arena_t *a, const char *s, int *failed) {
+    if (!s) return NULL;
+    for (size_t i = 0; i < sizeof(interned) / sizeof(interned[0]); i++) {
+        if (strcmp(s, interned[i]) == 0) return interned[i];
+    }
+    return arena_dup(a, s, failed);
+}
+
+static const char *view_strdup(nebo_view_builder_t *vb, const char *s) {
+    return arena_dup(&vb->arena, s, &vb->failed);
+}
+
+static const char *view_intern(nebo_view_builder_t *vb, const char *s) {
+    return arena_intern(&vb->arena, s, &vb->failed);
+}
+
+/** Deep-copy src into dst with every string in a. */
+static void copy_block(nebo_arena_t *a, nebo_ui_block_t *dst, const nebo_ui_block_t *src,
+                       int *failed) {
+    *dst = *src;
+    dst->block_id = arena_dup(a, src->block_id, failed);
+    dst->type = arena_intern(a, src->type, failed);
+    dst->text = arena_dup(a, src->text, failed);
+    dst->value = arena_intern(a, src->value, failed);
+    dst->placeholder = arena_dup(a, src->placeholder, failed);
+    dst->hint = arena_dup(a, src->hint, failed);
+    dst->variant = arena_intern(a, src->variant, failed);
+    dst->src = arena_dup(a, src->src, failed);
+    dst->alt = arena_dup(a, src->alt, failed);
+    dst->style = arena_intern(a, src->style, failed);
+    dst->options = NULL;
+    dst->options_count = 0;
+    if (src->options && src->options_count > 0) {
+        nebo_select_option_t *opts =
+            nebo_arena_alloc(a, (size_t)src->options_count * sizeof(nebo_select_option_t));
+        if (!opts) {
+            *failed = 1;
+            return;
+        }
+        for (int i = 0; i < src->options_count; i++) {
+            opts[i].label = arena_dup(a, src->options[i].label, failed);
+            opts[i].value = arena_dup(a, src->options[i].value, failed);
+        }
+        dst->options = opts;
+        dst->options_count = src->options_count;
+    }
+}
+
+static owned_view_t *owned_new(void) {
+    owned_view_t *owned = malloc(sizeof(owned_view_t));
+    if (!owned) return NULL;
+    memset(&owned->view, 0, sizeof(owned->view));
+    atomic_init(&owned->refs, 1);
+    owned->depth = 0;
+    owned->base = NULL;
+    nebo_arena_init(&owned->arena, VIEW_ARENA_BLOCK);
+    return owned;
+}
+
+/* ── Builder ─────────────────────────────────────────────────────────── */
+
+/** Append a zeroed block of the given (static) type, or NULL on OOM. */
+static nebo_ui_block_t *add_block(nebo_view_builder_t *vb, const char *type,
+                                  const char *block_id) {
+    if (vb->block_count == vb->block_cap) {
+        int cap = vb->block_cap ? vb->block_cap * 2 : VIEW_MIN_BLOCKS;
+        nebo_ui_block_t *blocks = realloc(vb->blocks, (size_t)cap * sizeof(*blocks));
+        if (!blocks) {
+            vb->failed = 1;
+            return NULL;
+        }
+        vb->blocks = blocks;
+        vb->block_cap = cap;
+    }
+    nebo_ui_block_t *blk = &vb->blocks[vb->block_count++];
+    memset(blk, 0, sizeof(*blk));
+    blk->type = type;
+    blk->block_id = view_strdup(vb, block_id);
+    return blk;
 }
 
 nebo_view_builder_t *nebo_view_new(const char *view_id, const char *title) {
     nebo_view_builder_t *vb = calloc(1, sizeof(nebo_view_builder_t));
     if (!vb) return NULL;
-    vb->view_id = strdup(view_id);
-    vb->title = strdup(title);
+    nebo_arena_init(&vb->arena, VIEW_ARENA_BLOCK);
+    vb->view_id = view_strdup(vb, view_id);
+    vb->title = view_strdup(vb, title);
+    if (vb->failed) {
+        nebo_view_free(vb);
+        return NULL;
+    }
     return vb;
 }
 
 nebo_view_builder_t *nebo_view_heading(nebo_view_builder_t *vb, const char *block_id,
                                         const char *text, const char *variant) {
-    if (!vb || vb->block_count >= MAX_BLOCKS) return vb;
-    nebo_ui_block_t *blk = &vb->blocks[vb->block_count++];
-    memset(blk, 0, sizeof(*blk));
-    blk->block_id = strdup(block_id);
-    blk->type = strdup("heading");
-    blk->text = strdup(text);
-    blk->variant = strdup(variant);
+    if (!vb) return vb;
+    nebo_ui_block_t *blk = add_block(vb, "heading", block_id);
+    if (!blk) return vb;
+    blk->text = view_strdup(vb, text);
+    blk->variant = view_intern(vb, variant);
     return vb;
 }
 
 nebo_view_builder_t *nebo_view_text(nebo_view_builder_t *vb, const char *block_id,
                                      const char *text) {
-    if (!vb || vb->block_count >= MAX_BLOCKS) return vb;
-    nebo_ui_block_t *blk = &vb->blocks[vb->block_count++];
-    memset(blk, 0, sizeof(*blk));
-    blk->block_id = strdup(block_id);
-    blk->type = strdup("text");
-    blk->text = strdup(text);
+    if (!vb) return vb;
+    nebo_ui_block_t *blk = add_block(vb, "text", block_id);
+    if (!blk) return vb;
+    blk->text = view_strdup(vb, text);
     return vb;
 }
 
 nebo_view_builder_t *nebo_view_button(nebo_view_builder_t *vb, const char *block_id,
                                        const char *text, const char *variant) {
-    if (!vb || vb->block_count >= MAX_BLOCKS) return vb;
-    nebo_ui_block_t *blk = &vb->blocks[vb->block_count++];
-    memset(blk, 0, sizeof(*blk));
-    blk->block_id = strdup(block_id);
-    blk->type = strdup("button");
-    blk->text = strdup(text);
-    blk->variant = strdup(variant);
+    if (!vb) return vb;
+    nebo_ui_block_t *blk = add_block(vb, "button", block_id);
+    if (!blk) return vb;
+    blk->text = view_strdup(vb, text);
+    blk->variant = view_intern(vb, variant);
     return vb;
 }
 
 nebo_view_builder_t *nebo_view_input(nebo_view_builder_t *vb, const char *block_id,
                                       const char *value, const char *placeholder) {
-    if (!vb || vb->block_count >= MAX_BLOCKS) return vb;
-    nebo_ui_block_t *blk = &vb->blocks[vb->block_count++];
-    memset(blk, 0, sizeof(*blk));
-    blk->block_id = strdup(block_id);
-    blk->type = strdup("input");
-    blk->value = (const char *)safe_strdup(value);
-    blk->placeholder = (const char *)safe_strdup(placeholder);
+    if (!vb) return vb;
+    nebo_ui_block_t *blk = add_block(vb, "input", block_id);
+    if (!blk) return vb;
+    blk->value = view_strdup(vb, value);
+    blk->placeholder = view_strdup(vb, placeholder);
     return vb;
 }
 
 nebo_view_builder_t *nebo_view_select(nebo_view_builder_t *vb, const char *block_id,
                                        const char *value,
                                        const nebo_select_option_t *options, int count) {
-    if (!vb || vb->block_count >= MAX_BLOCKS) return vb;
-    nebo_ui_block_t *blk = &vb->blocks[vb->block_count++];
-    memset(blk, 0, sizeof(*blk));
-    blk->block_id = strdup(block_id);
-    blk->type = strdup("select");
-    blk->value = (const char *)safe_strdup(value);
+    if (!vb) return vb;
+    nebo_ui_block_t *blk = add_block(vb, "select", block_id);
+    if (!blk) return vb;
+    blk->value = view_strdup(vb, value);
     if (options && count > 0) {
-        nebo_select_option_t *opts = calloc(count, sizeof(nebo_select_option_t));
+        nebo_select_option_t *opts =
+            nebo_arena_alloc(&vb->arena, (size_t)count * sizeof(nebo_select_option_t));
+        if (!opts) {
+            vb->failed = 1;
+            return vb;
+        }
         for (int i = 0; i < count; i++) {
-            opts[i].label = strdup(options[i].label);
-            opts[i].value = strdup(options[i].value);
+            opts[i].label = view_strdup(vb, options[i].label);
+            opts[i].value = view_strdup(vb, options[i].value);
         }
         blk->options = opts;
         blk->options_count = count;
@@ -98,95 +221,139 @@ nebo_view_builder_t *nebo_view_select(nebo_view_builder_t *vb, const char *block
 
 nebo_view_builder_t *nebo_view_toggle(nebo_view_builder_t *vb, const char *block_id,
                                        const char *text, int on) {
-    if (!vb || vb->block_count >= MAX_BLOCKS) return vb;
-    nebo_ui_block_t *blk = &vb->blocks[vb->block_count++];
-    memset(blk, 0, sizeof(*blk));
-    blk->block_id = strdup(block_id);
-    blk->type = strdup("toggle");
-    blk->text = strdup(text);
-    blk->value = strdup(on ? "true" : "false");
+    if (!vb) return vb;
+    nebo_ui_block_t *blk = add_block(vb, "toggle", block_id);
+    if (!blk) return vb;
+    blk->text = view_strdup(vb, text);
+    blk->value = on ? "true" : "false";
     return vb;
 }
 
 nebo_view_builder_t *nebo_view_divider(nebo_view_builder_t *vb, const char *block_id) {
-    if (!vb || vb->block_count >= MAX_BLOCKS) return vb;
-    nebo_ui_block_t *blk = &vb->blocks[vb->block_count++];
-    memset(blk, 0, sizeof(*blk));
-    blk->block_id = strdup(block_id);
-    blk->type = strdup("divider");
+    if (!vb) return vb;
+    add_block(vb, "divider", block_id);
     return vb;
 }
 
 nebo_view_builder_t *nebo_view_image(nebo_view_builder_t *vb, const char *block_id,
                                       const char *src, const char *alt) {
-    if (!vb || vb->block_count >= MAX_BLOCKS) return vb;
-    nebo_ui_block_t *blk = &vb->blocks[vb->block_count++];
-    memset(blk, 0, sizeof(*blk));
-    blk->block_id = strdup(block_id);
-    blk->type = strdup("image");
-    blk->src = strdup(src);
-    blk->alt = (const char *)safe_strdup(alt);
+    if (!vb) return vb;
+    nebo_ui_block_t *blk = add_block(vb, "image", block_id);
+    if (!blk) return vb;
+    blk->src = view_strdup(vb, src);
+    blk->alt = view_strdup(vb, alt);
     return vb;
 }
 
+/* ── Build ───────────────────────────────────────────────────────────── */
+
 nebo_ui_view_t *nebo_view_build(nebo_view_builder_t *vb) {
-    if (!vb) return NULL;
-    nebo_ui_view_t *view = calloc(1, sizeof(nebo_ui_view_t));
-    if (!view) return NULL;
+    if (!vb || vb->failed) return NULL;
+    owned_view_t *owned = owned_new();
+    if (!owned) return NULL;
 
-    view->view_id = strdup(vb->view_id);
-    view->title = strdup(vb->title);
+    nebo_ui_view_t *view = &owned->view;
+    view->view_id = vb->view_id;
+    view->title = vb->title;
     view->block_count = vb->block_count;
-
     if (vb->block_count > 0) {
-        view->blocks = calloc(vb->block_count, sizeof(nebo_ui_block_t));
-        memcpy(view->blocks, vb->blocks, vb->block_count * sizeof(nebo_ui_block_t));
-        /* Ownership of strdup'd strings transfers to the view */
-        memset(vb->blocks, 0, sizeof(vb->blocks));
-        vb->block_count = 0;
+        size_t size = (size_t)vb->block_count * sizeof(nebo_ui_block_t);
+        view->blocks = nebo_arena_alloc(&vb->arena, size);
+        if (!view->blocks) {
+            free(owned);
+            return NULL;
+        }
+        memcpy(view->blocks, vb->blocks, size);
     }
 
+    /* The arena moves to the view; the builder starts over with a fresh one,
+       keeping its id and title for the next build. */
+    owned->arena = vb->arena;
+    nebo_arena_init(&vb->arena, VIEW_ARENA_BLOCK);
+    vb->block_count = 0;
+    vb->view_id = view_strdup(vb, view->view_id);
+    vb->title = view_strdup(vb, view->title);
     return view;
 }
 
-static void free_block(nebo_ui_block_t *blk) {
-    if (!blk) return;
-    free((void *)blk->block_id);
-    free((void *)blk->type);
-    free((void *)blk->text);
-    free((void *)blk->value);
-    free((void *)blk->placeholder);
-    free((void *)blk->hint);
-    free((void *)blk->variant);
-    free((void *)blk->src);
-    free((void *)blk->alt);
-    free((void *)blk->style);
-    if (blk->options) {
-        for (int i = 0; i < blk->options_count; i++) {
-            free((void *)blk->options[i].label);
-            free((void *)blk->options[i].value);
-        }
-        free((void *)blk->options);
-    }
-}
-
 void nebo_view_free(nebo_view_builder_t *vb) {
     if (!vb) return;
-    free(vb->view_id);
-    free(vb->title);
-    for (int i = 0; i < vb->block_count; i++) {
-        free_block(&vb->blocks[i]);
-    }
+    nebo_arena_free(&vb->arena);
+    free(vb->blocks);
     free(vb);
 }
 
+/* ── Shared views ────────────────────────────────────────────────────── */
+
+nebo_ui_view_t *nebo_view_retain(nebo_ui_view_t *view) {
+    if (view) atomic_fetch_add_explicit(&((owned_view_t *)view)->refs, 1, memory_order_relaxed);
+    return view;
+}
+
 void nebo_view_free_view(nebo_ui_view_t *view) {
-    if (!view) return;
-    free((void *)view->view_id);
-    free((void *)view->title);
+    owned_view_t *owned = (owned_view_t *)view;
+    while (owned && atomic_fetch_sub_explicit(&owned->refs, 1, memory_order_acq_rel) == 1) {
+        owned_view_t *base = owned->base;
+        nebo_arena_free(&owned->arena);
+        free(owned);
+        owned = base;
+    }
+}
+
+const nebo_ui_block_t *nebo_view_find(const nebo_ui_view_t *view, const char *block_id) {
+    if (!view || !block_id) return NULL;
     for (int i = 0; i < view->block_count; i++) {
-        free_block(&view->blocks[i]);
+        const char *id = view->blocks[i].block_id;
+        if (id && strcmp(id, block_id) == 0) return &view->blocks[i];
     }
-    free(view->blocks);
-    free(view);
+    return NULL;
+}
+
+nebo_ui_view_t *nebo_view_derive(nebo_ui_view_t *base, const char *block_id,
+                                 const nebo_ui_block_t *block) {
+    const nebo_ui_block_t *target = nebo_view_find(base, block_id);
+    if (!target) return NULL;
+    owned_view_t *from = (owned_view_t *)base;
+    int at = (int)(target - base->blocks);
+    int flatten = from->depth + 1 >= VIEW_MAX_DEPTH;
+
+    owned_view_t *owned = owned_new();
+    if (!owned) return NULL;
+    nebo_ui_view_t *view = &owned->view;
+    nebo_arena_t *a = &owned->arena;
+    int failed = 0;
+    int n = base->block_count - (block ? 0 : 1);
+    if (n > 0) {
+        view->blocks = nebo_arena_alloc(a, (size_t)n * sizeof(nebo_ui_block_t));
+        if (!view->blocks) failed = 1;
+    }
+
+    if (!failed && flatten) {
+        view->view_id = arena_dup(a, base->view_id, &failed);
+        view->title = arena_dup(a, base->title, &failed);
+        for (int i = 0, j = 0; i < base->block_count; i++) {
+            if (i != at) copy_block(a, &view->blocks[j], &base->blocks[i], &failed);
+            if (i != at || block) j++;
+        }
+    } else if (!failed) {
+        view->view_id = base->view_id;
+        view->title = base->title;
+        if (n > 0) {
+            int skip = block ? 0 : 1;
+            memcpy(view->blocks, base->blocks, (size_t)at * sizeof(nebo_ui_block_t));
+            memcpy(view->blocks + at + 1 - skip, base->blocks + at + 1,
+                   (size_t)(base->block_count - at - 1) * sizeof(nebo_ui_block_t));
+        }
+        owned->base = from;
+        owned->depth = from->depth + 1;
+        nebo_view_retain(base);
+    }
+    if (!failed && block) copy_block(a, &view->blocks[at], block, &failed);
+    view->block_count = n;
+
+    if (failed) {
+        nebo_view_free_view(view);
+        return NULL;
+    }
+    return view;
 }
@@ -0,0 +1,236 @@
+/**
+ * Nebo C SDK — keyed view diffing.
+ *
+ * Blocks are matched by block_id through a hash of the old view's ids. The
+ * matched blocks that keep their relative order are the longest increasing
+ * run of old positions taken in new order; everything else is removed and
+ * inserted. Equal blocks cost one pointer compare per field when both views
+ * come from the builder, since types and variants are interned.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "view_internal.h"
+
+/** A patch and its ops in one allocation. */
+typedef struct {
+    nebo_view_patch_t patch; /* first: the public pointer is the allocation */
+    nebo_view_op_t ops[];
+} owned_patch_t;
+
+static int str_eq(const char *a, const char *b) {
+    return a == b || (a && b && strcmp(a, b) == 0);
+}
+
+static int block_eq(const nebo_ui_block_t *a, const nebo_ui_block_t *b) {
+    if (!str_eq(a->type, b->type) || !str_eq(a->text, b->text) ||
+        !str_eq(a->value, b->value) || !str_eq(a->placeholder, b->placeholder) ||
+        !str_eq(a->hint, b->hint) || !str_eq(a->variant, b->variant) ||
+        !str_eq(a->src, b->src) || !str_eq(a->alt, b->alt) ||
+        !str_eq(a->style, b->style) || a->disabled != b->disabled ||
+        a->options_count != b->options_count)
+        return 0;
+    for (int i = 0; i < a->options_count; i++) {
+        if (!str_eq(a->options[i].label, b->options[i].label) ||
+            !str_eq(a->options[i].value, b->options[i].value))
+            return 0;
+    }
+    return 1;
+}
+
+/* ── Id index ────────────────────────────────────────────────────────── */
+
+static uint32_t hash_id(const char *s) {
+    uint32_t h = 2166136261u;
+    for (; *s; s++) h = (h ^ (unsigned char)*s) * 16777619u;
+    return h;
+}
+
+/**
+ * Open-addressed table of old positions keyed by block_id; slots hold
+ * position + 1 so zero is empty. Only the first block with an id is indexed.
+ */
+static void index_ids(const nebo_ui_view_t *v, int *slots, uint32_t mask) {
+    for (int i = 0; i < v->block_count; i++) {
+        const char *id = v->blocks[i].block_id;
+        if (!id) continue;
+        uint32_t h = hash_id(id) & mask;
+        while (slots[h] && strcmp(v->blocks[slots[h] - 1].block_id, id) != 0) h = (h + 1) & mask;
+        if (!slots[h]) slots[h] = i + 1;
+    }
+}
+
+static int find_id(const nebo_ui_view_t *v, const int *slots, uint32_t mask, const char *id) {
+    uint32_t h = hash_id(id) & mask;
+    for (; slots[h]; h = (h + 1) & mask) {
+        if (strcmp(v->blocks[slots[h] - 1].block_id, id) == 0) return slots[h] - 1;
+    }
+    return -1;
+}
+
+/* ── Diff ────────────────────────────────────────────────────────────── */
+
+/**
+ * Mark in keep[] the new positions whose old positions (match[], -1 for
+ * none) form a longest increasing subsequence. tails and prev are scratch
+ * of n ints each.
+ */
+static void mark_stable(const int *match, int n, int *tails, int *prev, char *keep) {
+    int len = 0;
+    for (int j = 0; j < n; j++) {
+        if (match[j] < 0) continue;
+        int lo = 0, hi = len;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (match[tails[mid]] < match[j]) lo = mid + 1;
+            else hi = mid;
+        }
+        prev[j] = lo > 0 ? tails[lo - 1] : -1;
+        tails[lo] = j;
+        if (lo == len) len++;
+    }
+    for (int j = len ? tails[len - 1] : -1; j >= 0; j = prev[j]) keep[j] = 1;
+}
+
+static void add_op(nebo_view_patch_t *p, nebo_view_op_kind_t kind, int index,
+                   const nebo_ui_block_t *block, const char *block_id) {
+    nebo_view_op_t *op = (nebo_view_op_t *)&p->ops[p->op_count++];
+    op->kind = kind;
+    op->index = index;
+    op->block = block;
+    op->block_id = block_id;
+}
+
+nebo_view_patch_t *nebo_view_diff(const nebo_ui_view_t *old_view,
+                                  const nebo_ui_view_t *new_view) {
+    static const nebo_ui_view_t empty = {0};
+    if (!new_view) return NULL;
+    const nebo_ui_view_t *ov = old_view ? old_view : &empty;
+    int n_old = ov->block_count, n_new = new_view->block_count;
+
+    owned_patch_t *owned =
+        malloc(sizeof(owned_patch_t) + (size_t)(n_old + n_new) * sizeof(nebo_view_op_t));
+    if (!owned) return NULL;
+    nebo_view_patch_t *p = &owned->patch;
+    p->view_id = new_view->view_id;
+    p->title = !old_view || !str_eq(ov->title, new_view->title) ? new_view->title : NULL;
+    p->ops = owned->ops;
+    p->op_count = 0;
+
+    uint32_t slots_n = 16;
+    while (slots_n < 2u * (uint32_t)n_old) slots_n *= 2;
+    /* Scratch: slots, match, tails, prev, then the byte flags. */
+    size_t ints = slots_n + 3 * (size_t)n_new;
+    int *scratch = calloc(1, ints * sizeof(int) + (size_t)n_new + (size_t)n_old + 1);
+    if (!scratch) {
+        free(owned);
+        return NULL;
+    }
+    int *slots = scratch;
+    int *match = slots + slots_n;
+    int *tails = match + n_new;
+    int *prev = tails + n_new;
+    char *keep = (char *)(prev + n_new); /* per new position: stays put */
+    char *kept = keep + n_new;           /* per old position: stays put */
+
+    index_ids(ov, slots, slots_n - 1);
+    for (int j = 0; j < n_new; j++) {
+        const char *id = new_view->blocks[j].block_id;
+        int i = id ? find_id(ov, slots, slots_n - 1, id) : -1;
+        /* Claim the old block once; a duplicate id in the new view inserts. */
+        if (i >= 0 && kept[i]) i = -1;
+        if (i >= 0) kept[i] = 1;
+        match[j] = i;
+    }
+    memset(kept, 0, (size_t)n_old);
+    mark_stable(match, n_new, tails, prev, keep);
+    for (int j = 0; j < n_new; j++) {
+        if (keep[j]) kept[match[j]] = 1;
+    }
+
+    for (int i = n_old - 1; i >= 0; i--) {
+        if (!kept[i]) add_op(p, NEBO_VIEW_OP_REMOVE, i, NULL, ov->blocks[i].block_id);
+    }
+    for (int j = 0; j < n_new; j++) {
+        const nebo_ui_block_t *b = &new_view->blocks[j];
+        if (!keep[j]) add_op(p, NEBO_VIEW_OP_INSERT, j, b, b->block_id);
+    }
+    for (int j = 0; j < n_new; j++) {
+        const nebo_ui_block_t *b = &new_view->blocks[j];
+        if (keep[j] && !block_eq(&ov->blocks[match[j]], b))
+            add_op(p, NEBO_VIEW_OP_UPDATE, j, b, b->block_id);
+    }
+    free(scratch);
+    return p;
+}
+
+void nebo_view_patch_free(nebo_view_patch_t *patch) {
+    free(patch);
+}
+
+/* ── JSON ────────────────────────────────────────────────────────────── */
+
+static void write_field(nebo_json_writer_t *w, const char *key, const char *value) {
+    if (!value) return;
+    nebo_json_write_key(w, key);
+    nebo_json_write_string(w, value);
+}
+
+void nebo_view_write_block_json(nebo_json_writer_t *w, const nebo_ui_block_t *b) {
+    nebo_json_write_begin_object(w);
+    write_field(w, "block_id", b->block_id);
+    write_field(w, "type", b->type);
+    write_field(w, "text", b->text);
+    write_field(w, "value", b->value);
+    write_field(w, "placeholder", b->placeholder);
+    write_field(w, "hint", b->hint);
+    write_field(w, "variant", b->variant);
+    write_field(w, "src", b->src);
+    write_field(w, "alt", b->alt);
+    write_field(w, "style", b->style);
+    if (b->disabled) {
+        nebo_json_write_key(w, "disabled");
+        nebo_json_write_bool(w, 1);
+    }
+    if (b->options && b->options_count > 0) {
+        nebo_json_write_key(w, "options");
+        nebo_json_write_begin_array(w);
+        for (int i = 0; i < b->options_count; i++) {
+            nebo_json_write_begin_object(w);
+            write_field(w, "label", b->options[i].label);
+            write_field(w, "value", b->options[i].value);
+            nebo_json_write_end_object(w);
+        }
+        nebo_json_write_end_array(w);
+    }
+    nebo_json_write_end_object(w);
+}
+
+void nebo_view_patch_write_json(const nebo_view_patch_t *patch, nebo_json_writer_t *w) {
+    static const char *const op_names[] = {"remove", "insert", "update"};
+    if (!patch || !w) return;
+    nebo_json_write_begin_object(w);
+    write_field(w, "view_id", patch->view_id);
+    write_field(w, "title", patch->title);
+    nebo_json_write_key(w, "ops");
+    nebo_json_write_begin_array(w);
+    for (int i = 0; i < patch->op_count; i++) {
+        const nebo_view_op_t *op = &patch->ops[i];
+        nebo_json_write_begin_object(w);
+        nebo_json_write_key(w, "op");
+        nebo_json_write_string(w, op_names[op->kind]);
+        nebo_json_write_key(w, "index");
+        nebo_json_write_int(w, op->index);
+        if (op->kind == NEBO_VIEW_OP_REMOVE) {
+            write_field(w, "block_id", op->block_id);
+        } else {
+            nebo_json_write_key(w, "block");
+            nebo_view_write_block_json(w, op->block);
+        }
+        nebo_json_write_end_object(w);
+    }
+    nebo_json_write_end_array(w);
+    nebo_json_write_end_object(w);
+}
@@ -0,0 +1,17 @@
+#ifndef NEBO_VIEW_INTERNAL_H
+#define NEBO_VIEW_INTERNAL_H
+
+#include "nebo/view.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** One block as a JSON object; unset fields are left out. Shared by patches and the renderer. */
+void nebo_view_write_block_json(nebo_json_writer_t *w, const nebo_ui_block_t *b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NEBO_VIEW_INTERNAL_H */
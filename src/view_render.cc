@@ -0,0 +1,484 @@
+/**
+ * Nebo C SDK — view renderer with a per-block output cache.
+ *
+ * A block's cache key is its content: every field, NULL-ness included,
+ * prefixed with the output format. A hit costs hashing the block's strings
+ * in place and comparing them with the stored key instead of escaping and
+ * encoding. A render where every block hits runs under the shared lock only.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include "json_writer.h"
+#include "view_internal.h"
+}
+
+static const size_t kDefaultMaxBytes = 4u << 20;
+
+/* ── Encoders ────────────────────────────────────────────────────────── */
+
+/* Throws std::bad_alloc rather than return an encoding that is not a block. */
+static std::string block_json(const nebo_ui_block_t *b) {
+    nebo_json_writer_t *w = nebo_json_writer_new(256);
+    if (!w) throw std::bad_alloc();
+    nebo_view_write_block_json(w, b);
+    if (w->failed) {
+        nebo_json_writer_free(w);
+        throw std::bad_alloc();
+    }
+    std::string out;
+    try {
+        out.assign(w->buf, w->len);
+    } catch (...) {
+        nebo_json_writer_free(w);
+        throw;
+    }
+    nebo_json_writer_free(w);
+    return out;
+}
+
+static void html_escape(std::string &out, const char *s) {
+    if (!s) return;
+    const char *run = s;
+    for (; *s; s++) {
+        const char *rep;
+        switch (*s) {
+        case '&': rep = "&amp;"; break;
+        case '<': rep = "&lt;"; break;
+        case '>': rep = "&gt;"; break;
+        case '"': rep = "&quot;"; break;
+        case '\'': rep = "&#39;"; break;
+        default: continue;
+        }
+        out.append(run, s - run);
+        out.append(rep);
+        run = s + 1;
+    }
+    out.append(run, s - run);
+}
+
+/** name="value" with a leading space; nothing when value is NULL. */
+static void html_attr(std::string &out, const char *name, const char *value) {
+    if (!value) return;
+    out += ' ';
+    out += name;
+    out += "=\"";
+    html_escape(out, value);
+    out += '"';
+}
+
+static bool is(const char *s, const char *lit) {
+    return s && strcmp(s, lit) == 0;
+}
+
+static void block_html(std::string &out, const nebo_ui_block_t *b) {
+    const char *type = b->type ? b->type : "text";
+    out += "<div class=\"nebo-block nebo-";
+    html_escape(out, type);
+    if (b->style) {
+        out += " nebo-";
+        html_escape(out, b->style);
+    }
+    out += '"';
+    html_attr(out, "data-block-id", b->block_id);
+    out += '>';
+
+    const char *disabled = b->disabled ? " disabled" : "";
+    if (is(type, "heading")) {
+        const char *tag = is(b->variant, "h1") || is(b->variant, "h3") ? b->variant : "h2";
+        out += '<';
+        out += tag;
+        out += '>';
+        html_escape(out, b->text);
+        out += "</";
+        out += tag;
+        out += '>';
+    } else if (is(type, "button")) {
+        out += "<button type=\"button\"";
+        html_attr(out, "name", b->block_id);
+        if (b->variant) {
+            out += " class=\"nebo-";
+            html_escape(out, b->variant);
+            out += '"';
+        }
+        out += disabled;
+        out += '>';
+        html_escape(out, b->text);
+        out += "</button>";
+    } else if (is(type, "input")) {
+        out += "<input type=\"text\"";
+        html_attr(out, "name", b->block_id);
+        html_attr(out, "value", b->value);
+        html_attr(out, "placeholder", b->placeholder);
+        out += disabled;
+        out += '>';
+    } else if (is(type, "select")) {
+        out += "<select";
+        html_attr(out, "name", b->block_id);
+        out += disabled;
+        out += '>';
+        for (int i = 0; b->options && i < b->options_count; i++) {
+            out += "<option";
+            html_attr(out, "value", b->options[i].value);
+            const char *value = b->options[i].value;
+            if (value && is(b->value, value)) out += " selected";
+            out += '>';
+            html_escape(out, b->options[i].label);
+            out += "</option>";
+        }
+        out += "</select>";
+    } else if (is(type, "toggle")) {
+        out += "<label><input type=\"checkbox\"";
+        html_attr(out, "name", b->block_id);
+        if (is(b->value, "true")) out += " checked";
+        out += disabled;
+        out += "> ";
+        html_escape(out, b->text);
+        out += "</label>";
+    } else if (is(type, "divider")) {
+        out += "<hr>";
+    } else if (is(type, "image")) {
+        out += "<img";
+        html_attr(out, "src", b->src);
+        html_attr(out, "alt", b->alt ? b->alt : "");
+        out += '>';
+    } else {
+        out += "<p>";
+        html_escape(out, b->text);
+        out += "</p>";
+    }
+
+    if (b->hint) {
+        out += "<small class=\"nebo-hint\">";
+        html_escape(out, b->hint);
+        out += "</small>";
+    }
+    out += "</div>";
+}
+
+/* ── Cache keys ──────────────────────────────────────────────────────── */
+
+/**
+ * A block's key walks its content in a fixed order: format, disabled, then
+ * every string as '\1' (NULL) or '\2' + bytes + NUL, then the options.
+ * The same walk serializes a key (on insert), hashes a block and matches a
+ * block against a stored key, so a lookup never copies the block.
+ */
+template <class V>
+static void visit_key(V &v, char format, const nebo_ui_block_t *b) {
+    v.byte(format);
+    v.byte(b->disabled ? '\1' : '\0');
+    v.field(b->block_id);
+    v.field(b->type);
+    v.field(b->text);
+    v.field(b->value);
+    v.field(b->placeholder);
+    v.field(b->hint);
+    v.field(b->variant);
+    v.field(b->src);
+    v.field(b->alt);
+    v.field(b->style);
+    int n = b->options ? b->options_count : 0;
+    v.bytes(&n, sizeof(n));
+    for (int i = 0; i < n; i++) {
+        v.field(b->options[i].label);
+        v.field(b->options[i].value);
+    }
+}
+
+struct KeyWriter {
+    std::string key;
+    void byte(char c) { key += c; }
+    void bytes(const void *p, size_t n) { key.append(static_cast<const char *>(p), n); }
+    void field(const char *s) {
+        if (!s) return byte('\1');
+        byte('\2');
+        key.append(s, strlen(s) + 1);
+    }
+};
+
+struct KeyHasher {
+    uint64_t h = 0x243F6A8885A308D3ull;
+    void mix(uint64_t v) {
+        h = (h ^ v) * 0x9E3779B97F4A7C15ull;
+        h = (h << 31) | (h >> 33);
+    }
+    void byte(char c) { mix((unsigned char)c); }
+    void bytes(const void *p, size_t n) {
+        const char *s = static_cast<const char *>(p);
+        mix(n);
+        for (; n >= 8; n -= 8, s += 8) {
+            uint64_t w;
+            memcpy(&w, s, 8);
+            mix(w);
+        }
+        /* A variable-length memcpy here would be a libc call per field. */
+        uint64_t w = 0;
+        for (size_t i = 0; i < n; i++) w |= (uint64_t)(unsigned char)s[i] << (8 * i);
+        mix(w);
+    }
+    void field(const char *s) {
+        if (!s) return mix(~0ull);
+        bytes(s, strlen(s));
+    }
+    uint64_t Digest() const {
+        uint64_t d = (h ^ (h >> 29)) * 0xBF58476D1CE4E5B9ull;
+        return d ^ (d >> 32);
+    }
+};
+
+struct KeyMatcher {
+    const char *p;
+    const char *end;
+    bool ok = true;
+    void bytes(const void *d, size_t n) {
+        if (!ok || (size_t)(end - p) < n || memcmp(p, d, n) != 0) {
+            ok = false;
+            return;
+        }
+        p += n;
+    }
+    void byte(char c) { bytes(&c, 1); }
+    void field(const char *s) {
+        if (!s) return byte('\1');
+        byte('\2');
+        bytes(s, strlen(s) + 1);
+    }
+};
+
+static uint64_t key_hash(char format, const nebo_ui_block_t *b) {
+    KeyHasher h;
+    visit_key(h, format, b);
+    return h.Digest();
+}
+
+static bool key_matches(const std::string &key, char format, const nebo_ui_block_t *b) {
+    KeyMatcher m{key.data(), key.data() + key.size()};
+    visit_key(m, format, b);
+    return m.ok && m.p == m.end;
+}
+
+/* ── Cache ───────────────────────────────────────────────────────────── */
+
+/**
+ * Byte-bounded cache of encoded blocks keyed by content. Lookups share the
+ * lock and only set a reference bit; eviction is CLOCK (second chance), so
+ * a hit never reorders the list.
+ */
+struct nebo_view_renderer {
+    explicit nebo_view_renderer(size_t max_bytes)
+        : max_bytes_(max_bytes ? max_bytes : kDefaultMaxBytes) {}
+
+    /**
+     * Emits the encoded bytes of every block of view in format, in order,
+     * through emit(const std::string &). Misses are encoded with
+     * encode(std::string &, const nebo_ui_block_t *) outside the lock and
+     * then cached.
+     */
+    template <class Encode, class Emit>
+    void Render(const nebo_ui_view_t *view, char format, Encode encode, Emit emit) {
+        size_t n = view->block_count > 0 ? (size_t)view->block_count : 0;
+        const nebo_ui_block_t *blocks = view->blocks;
+        std::vector<uint64_t> hashes(n);
+        for (size_t i = 0; i < n; i++) hashes[i] = key_hash(format, &blocks[i]);
+
+        std::vector<Entry *> hits(n);
+        size_t missing = 0;
+        {
+            std::shared_lock<std::shared_mutex> lk(mu_);
+            for (size_t i = 0; i < n; i++) {
+                hits[i] = Find(hashes[i], format, &blocks[i]);
+                if (!hits[i]) {
+                    missing++;
+                    continue;
+                }
+                hits[i]->referenced.store(true, std::memory_order_relaxed);
+            }
+            hits_.fetch_add(n - missing, std::memory_order_relaxed);
+            misses_.fetch_add(missing, std::memory_order_relaxed);
+            if (!missing) {
+                for (Entry *e : hits) emit(e->content);
+                return;
+            }
+        }
+
+        std::vector<std::string> fresh(n);
+        for (size_t i = 0; i < n; i++) {
+            if (!hits[i]) encode(fresh[i], &blocks[i]);
+        }
+        std::unique_lock<std::shared_mutex> lk(mu_);
+        for (size_t i = 0; i < n; i++) {
+            if (!hits[i]) {
+                emit(fresh[i]);
+                continue;
+            }
+            /* An entry looked up before may have been evicted since. */
+            if (Entry *e = Find(hashes[i], format, &blocks[i])) {
+                emit(e->content);
+            } else {
+                encode(fresh[i], &blocks[i]);
+                emit(fresh[i]);
+            }
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (!fresh[i].empty()) Insert(hashes[i], format, &blocks[i], std::move(fresh[i]));
+        }
+    }
+
+    nebo_view_render_stats_t Stats() {
+        std::shared_lock<std::shared_mutex> lk(mu_);
+        nebo_view_render_stats_t s = stats_;
+        s.hits = hits_.load(std::memory_order_relaxed);
+        s.misses = misses_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    struct Entry {
+        Entry(uint64_t hash, std::string key, std::string content)
+            : hash(hash), key(std::move(key)), content(std::move(content)) {}
+        uint64_t hash;
+        std::string key;
+        std::string content;
+        std::atomic<bool> referenced{false};
+    };
+
+    struct Identity {
+        size_t operator()(uint64_t h) const { return (size_t)h; }
+    };
+
+    Entry *Find(uint64_t hash, char format, const nebo_ui_block_t *b) {
+        auto it = index_.find(hash);
+        if (it == index_.end() || !key_matches(it->second->key, format, b)) return nullptr;
+        return &*it->second;
+    }
+
+    void Erase(std::list<Entry>::iterator it) {
+        stats_.bytes -= it->key.size() + it->content.size();
+        stats_.entries--;
+        index_.erase(it->hash);
+        lru_.erase(it);
+    }
+
+    void Insert(uint64_t hash, char format, const nebo_ui_block_t *b, std::string content) {
+        auto old = index_.find(hash);
+        if (old != index_.end()) {
+            if (key_matches(old->second->key, format, b)) return; /* a racing render won */
+            Erase(old->second); /* 64-bit hash collision: the newer block wins */
+        }
+        KeyWriter kw;
+        visit_key(kw, format, b);
+        size_t size = kw.key.size() + content.size();
+        if (size > max_bytes_) return;
+        while (stats_.bytes + size > max_bytes_ && !lru_.empty()) {
+            auto victim = std::prev(lru_.end());
+            if (victim->referenced.exchange(false, std::memory_order_relaxed)) {
+                lru_.splice(lru_.begin(), lru_, victim);
+                continue;
+            }
+            Erase(victim);
+            stats_.evictions++;
+        }
+        lru_.emplace_front(hash, std::move(kw.key), std::move(content));
+        index_.emplace(hash, lru_.begin());
+        stats_.bytes += size;
+        stats_.entries++;
+    }
+
+    size_t max_bytes_;
+    std::shared_mutex mu_;
+    std::list<Entry> lru_; /* front = newest; the clock hand is the back */
+    std::unordered_map<uint64_t, std::list<Entry>::iterator, Identity> index_;
+    std::atomic<unsigned long long> hits_{0};
+    std::atomic<unsigned long long> misses_{0};
+    nebo_view_render_stats_t stats_{}; /* entries, bytes, evictions */
+};
+
+/* ── C API ───────────────────────────────────────────────────────────── */
+
+extern "C" nebo_view_renderer_t *nebo_view_renderer_new(size_t max_bytes) {
+    return new (std::nothrow) nebo_view_renderer(max_bytes);
+}
+
+extern "C" void nebo_view_render_json(nebo_view_renderer_t *r, const nebo_ui_view_t *view,
+                                      nebo_json_writer_t *w) {
+    if (!view || !w) return;
+    nebo_json_write_begin_object(w);
+    if (view->view_id) {
+        nebo_json_write_key(w, "view_id");
+        nebo_json_write_string(w, view->view_id);
+    }
+    if (view->title) {
+        nebo_json_write_key(w, "title");
+        nebo_json_write_string(w, view->title);
+    }
+    nebo_json_write_key(w, "blocks");
+    nebo_json_write_begin_array(w);
+    if (r) {
+        try {
+            r->Render(
+                view, 'j', [](std::string &out, const nebo_ui_block_t *b) { out = block_json(b); },
+                [w](const std::string &f) { nebo_json_write_raw(w, f.data(), f.size()); });
+        } catch (const std::bad_alloc &) {
+            w->failed = 1; /* reported by nebo_json_writer_finish() */
+            return;
+        }
+    } else {
+        for (int i = 0; i < view->block_count; i++)
+            nebo_view_write_block_json(w, &view->blocks[i]);
+    }
+    nebo_json_write_end_array(w);
+    nebo_json_write_end_object(w);
+}
+
+extern "C" int nebo_view_render_html(nebo_view_renderer_t *r, const nebo_ui_view_t *view,
+                                     char **out, size_t *len) {
+    if (!view || !out) return -1;
+    try {
+        std::string html;
+        html.reserve(64 + (size_t)(view->block_count > 0 ? view->block_count : 0) * 160);
+        html += "<div class=\"nebo-view\"";
+        html_attr(html, "data-view-id", view->view_id);
+        html += '>';
+        if (view->title) {
+            html += "<h1 class=\"nebo-title\">";
+            html_escape(html, view->title);
+            html += "</h1>";
+        }
+        if (r) {
+            r->Render(view, 'h', block_html, [&html](const std::string &f) { html += f; });
+        } else {
+            for (int i = 0; i < view->block_count; i++) block_html(html, &view->blocks[i]);
+        }
+        html += "</div>";
+
+        char *buf = static_cast<char *>(malloc(html.size() + 1));
+        if (!buf) return -1;
+        memcpy(buf, html.c_str(), html.size() + 1);
+        *out = buf;
+        if (len) *len = html.size();
+        return 0;
+    } catch (const std::bad_alloc &) {
+        return -1;
+    }
+}
+
+extern "C" void nebo_view_renderer_stats(nebo_view_renderer_t *r, nebo_view_render_stats_t *out) {
+    if (!out) return;
+    *out = r ? r->Stats() : nebo_view_render_stats_t{};
+}
+
+extern "C" void nebo_view_renderer_free(nebo_view_renderer_t *r) {
+    delete r;
+}